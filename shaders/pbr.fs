@@ -3,21 +3,22 @@ out vec4 FragColor;
 
 in vec3 FragPos;
 in vec3 Normal;
-
-uniform vec3 objectColor;
-uniform float roughness;
-uniform float metallic;
-uniform vec3 camPos;
-
-uniform float emissionStrength;
-uniform vec3 emissionColor;
-uniform float fade;
-
-// Fog
-uniform int useFog;
-uniform vec3 fogColor;
-uniform float fogNear;
-uniform float fogFar;
+in vec3 Albedo;
+in float Metallic;
+in float Roughness;
+
+// Константы кадра (тот же блок, что и в pbr.vs)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 camPos;            // xyz
+    vec4 lightPositions[2];
+    vec4 lightColors[2];
+    vec4 fogColor;          // rgb, w = useFog
+    vec4 fogParams;         // x = near, y = far
+    vec4 emission;          // rgb = color, w = strength
+    vec4 misc;              // x = fade
+};
 
 void main()
 {
@@ -25,33 +26,33 @@ void main()
     vec3 lightPos = vec3(10,20,10);
     vec3 N = normalize(Normal);
     vec3 L = normalize(lightPos - FragPos);
-    vec3 V = normalize(camPos - FragPos);
+    vec3 V = normalize(camPos.xyz - FragPos);
     vec3 H = normalize(V + L);
 
     float diff = max(dot(N, L), 0.0);
     float spec = pow(max(dot(N, H), 0.0), 32.0); // ярче бликов
 
     // осветил базовый цвет
-    vec3 litColor = objectColor * (diff * 1.5 + 0.3) + spec * metallic * 1.5;
+    vec3 litColor = Albedo * (diff * 1.5 + 0.3) + spec * Metallic * 1.5;
 
     // --- Emission (glow) ---
-    vec3 emission = emissionColor * emissionStrength;
+    vec3 glow = emission.rgb * emission.w;
 
     // глянец по краю
     float edge = pow(1.0 - max(dot(N, V), 0.0), 2.0);
-    emission *= edge;
+    glow *= edge;
 
-    litColor += emission;
+    litColor += glow;
 
     // Fade-in
-    litColor *= fade;
+    litColor *= misc.x;
 
     // Fog
-    if(useFog == 1)
+    if(fogColor.w > 0.5)
     {
-        float dist = length(camPos - FragPos);
-        float fogFactor = clamp((dist - fogNear) / (fogFar - fogNear), 0.0, 1.0);
-        vec3 finalColor = mix(litColor, fogColor, fogFactor);
+        float dist = length(camPos.xyz - FragPos);
+        float fogFactor = clamp((dist - fogParams.x) / (fogParams.y - fogParams.x), 0.0, 1.0);
+        vec3 finalColor = mix(litColor, fogColor.rgb, fogFactor);
         FragColor = vec4(finalColor, 1.0);
     }
     else
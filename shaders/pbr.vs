@@ -2,16 +2,37 @@
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Per-instance (glVertexAttribDivisor = 1)
+layout(location = 2) in mat4 aModel;     // занимает 2..5
+layout(location = 6) in vec3 aAlbedo;
+layout(location = 7) in vec2 aMaterial;  // x = metallic, y = roughness
+layout(location = 8) in mat3 aNormalMatrix; // занимает 8..10, считается на CPU
+
+// Константы кадра, обновляются один раз за кадр (см. FrameConstants в Renderer.h)
+layout(std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 camPos;
+    vec4 lightPositions[2];
+    vec4 lightColors[2];
+    vec4 fogColor;
+    vec4 fogParams;
+    vec4 emission;
+    vec4 misc;
+};
 
 out vec3 FragPos;
 out vec3 Normal;
+out vec3 Albedo;
+out float Metallic;
+out float Roughness;
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos,1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    FragPos = vec3(aModel * vec4(aPos,1.0));
+    Normal = aNormalMatrix * aNormal;
+    Albedo = aAlbedo;
+    Metallic = aMaterial.x;
+    Roughness = aMaterial.y;
     gl_Position = projection * view * vec4(FragPos,1.0);
 }
@@ -0,0 +1,115 @@
+// BoardView.cpp
+#include "BoardView.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+static const glm::vec3 colors[] = {
+    {0.2f, 0.8f, 0.8f}, // I
+    {0.9f, 0.8f, 0.2f}, // O
+    {0.7f, 0.2f, 0.8f}, // T
+    {0.8f, 0.5f, 0.2f}, // L
+    {0.2f, 0.4f, 0.8f}, // J
+    {0.2f, 0.8f, 0.4f}, // S
+    {0.8f, 0.2f, 0.2f}  // Z
+};
+
+BoardCamera boardCamera(int width, int height) {
+    float extent = std::max((float)height, 1.2f * width);
+    glm::vec3 target = {(width - 1) * 0.5f, height * 0.3f, 0.0f};
+    BoardCamera cam;
+    cam.position = {target.x, target.y + extent * 0.3f, extent};
+    cam.view = glm::lookAt(cam.position, target, {0,1,0});
+    cam.farPlane = std::max(100.0f, extent * 4.0f);
+    return cam;
+}
+
+CubeInstance boardCell(int x, int y, int cellValue) {
+    if(cellValue == 0) {
+        CubeInstance empty;
+        empty.model = glm::mat4(0.0f);
+        empty.normalMatrix = glm::mat3(0.0f);
+        empty.albedo = glm::vec3(0.0f);
+        empty.metallic = empty.roughness = 0.0f;
+        return empty;
+    }
+    glm::mat4 model = glm::translate(glm::mat4(1.0f),{(float)x,(float)y,0.0f});
+    model = glm::scale(model,{0.45f,0.45f,0.45f});
+    return {model, colors[cellValue-1],0.1f,0.7f};
+}
+
+std::vector<CubeInstance> buildWalls(int width, int height) {
+    std::vector<CubeInstance> wallCubes;
+    glm::vec3 wallColor(0.4f, 0.4f, 0.5f);
+    for (int y = -1; y < height + 1; ++y) {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), {-0.8f, (float)y, 0.0f});
+        model = glm::scale(model, {0.4f, 0.5f, 0.5f});
+        wallCubes.push_back({model, wallColor, 0.3f, 0.8f});
+
+        model = glm::translate(glm::mat4(1.0f), {width - 0.2f, (float)y, 0.0f});
+        model = glm::scale(model, {0.4f, 0.5f, 0.5f});
+        wallCubes.push_back({model, wallColor, 0.3f, 0.8f});
+    }
+
+    for(int x=-1;x<width+1;++x){
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), { (float)x, -0.8f, 0.0f});
+        model = glm::scale(model, {0.5f, 0.4f, 0.5f});
+        wallCubes.push_back({model, wallColor, 0.3f, 0.8f});
+    }
+
+    for(int x=-2;x<width+2;++x)
+        for(int y=-2;y<height+2;++y){
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), {(float)x,(float)y,-0.6f});
+            model = glm::scale(model,{0.5f,0.5f,0.4f});
+            wallCubes.push_back({model,{0.2f,0.2f,0.25f},0.4f,0.9f});
+        }
+    return wallCubes;
+}
+
+BoardView::BoardView(Renderer &renderer, int width, int height)
+    : renderer(renderer), width(width)
+{
+    wallBatch = renderer.createBatch(buildWalls(width, height));
+    boardBatch = renderer.createBatch(std::vector<CubeInstance>(width * height, boardCell(0, 0, 0)), true);
+}
+
+void BoardView::update(DynamicGame &game) {
+    int first, last;
+    if(!game.getDirtyRows(first, last)) return;
+
+    const auto &grid = game.getGrid();
+    boardCubes.clear();
+    for(int y=first;y<=last;++y)
+        for(int x=0;x<width;++x)
+            boardCubes.push_back(boardCell(x, y, grid[y*width+x]));
+    renderer.updateBatch(boardBatch, (size_t)first*width, boardCubes.data(), boardCubes.size());
+    game.clearDirtyRows();
+}
+
+void BoardView::drawWalls() {
+    renderer.drawBatch(wallBatch);
+}
+
+void BoardView::drawBoard() {
+    renderer.drawBatch(boardBatch);
+}
+
+void BoardView::drawActivePiece(const DynamicGame &game, const Piece &prevActive, float alpha) {
+    if(game.isGameOver()) return;
+
+    Piece cur = game.getActive();
+    float px = (float)cur.x, py = (float)cur.y;
+    if(prevActive.type == cur.type && prevActive.rotation == cur.rotation &&
+       std::abs(cur.x - prevActive.x) <= 1 && std::abs(cur.y - prevActive.y) <= 1) {
+        px = glm::mix((float)prevActive.x, px, alpha);
+        py = glm::mix((float)prevActive.y, py, alpha);
+    }
+
+    activeCubes.clear();
+    for(auto &c : cur.cells()) {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f),{px + c.x, py + c.y, 0.0f});
+        model = glm::scale(model,{0.45f,0.45f,0.45f});
+        activeCubes.push_back({model, colors[cur.colorIndex()-1],0.1f,0.7f});
+    }
+    renderer.drawCubes(activeCubes);
+}
@@ -0,0 +1,43 @@
+// BoardView.h
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include "Renderer.h"
+#include "Game.h"
+
+// Камера смотрит на центр поля; расстояние растёт с размером поля (10x20 -> как раньше)
+struct BoardCamera {
+    glm::vec3 position;
+    glm::mat4 view;
+    float farPlane;
+};
+
+BoardCamera boardCamera(int width, int height);
+
+// Клетка поля -> свой слот в постоянном буфере; пустая клетка = куб нулевого размера
+CubeInstance boardCell(int x, int y, int cellValue);
+
+// Стены, пол и задняя сетка не двигаются: собираются один раз (и при смене размера поля)
+std::vector<CubeInstance> buildWalls(int width, int height);
+
+// Поле в 3D поверх Renderer: стены и клетки — постоянные батчи, активная фигура
+// заливается каждый кадр. Общий код игры и tetris_render_bench.
+class BoardView {
+public:
+    BoardView(Renderer &renderer, int width, int height);
+
+    // Перезаливает только строки, изменённые с прошлого кадра (между фиксациями фигур — ничего)
+    void update(DynamicGame &game);
+    void drawWalls();
+    void drawBoard();
+    // Активная фигура между двумя тиками: если это та же фигура и она сдвинулась
+    // на одну клетку, рисуется промежуточное положение, иначе — текущее.
+    void drawActivePiece(const DynamicGame &game, const Piece &prevActive, float alpha);
+
+private:
+    Renderer &renderer;
+    int width;
+    int wallBatch, boardBatch;
+    std::vector<CubeInstance> boardCubes;
+    std::vector<CubeInstance> activeCubes;
+};
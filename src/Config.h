@@ -3,8 +3,7 @@
 #include <glm/glm.hpp>
 
 namespace Config {
-    const int GRID_WIDTH = 10;
-    const int GRID_HEIGHT = 20;
+    // Размер поля задаётся при создании Game (Game::DEFAULT_WIDTH/DEFAULT_HEIGHT)
     const float FALL_INTERVAL = 0.7f; // скорость падения
     const glm::vec3 COLORS[] = {
         {1.0f,0.3f,0.3f},
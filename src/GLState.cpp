@@ -0,0 +1,131 @@
+//GLState.cpp
+#include "GLState.h"
+#include <glad/glad.h>
+#include "Profiler.h"
+
+namespace glstate {
+
+namespace {
+
+// Значение, которого не бывает у объектов GL: после invalidate() совпадений нет
+const unsigned int UNKNOWN = ~0u;
+
+enum Cap { CAP_DEPTH_TEST, CAP_BLEND, CAP_CULL_FACE, CAP_COUNT };
+
+struct Cache {
+    unsigned int program = UNKNOWN, vao = UNKNOWN;
+    unsigned int arrayBuffer = UNKNOWN, uniformBuffer = UNKNOWN;
+    int viewport[4] = {-1, -1, -1, -1};
+    int caps[CAP_COUNT] = {-1, -1, -1};   // -1 — неизвестно
+    unsigned int blendSrc = UNKNOWN, blendDst = UNKNOWN;
+    int depthMask = -1;
+};
+
+Cache cache;
+Stats stats = {0, 0};
+
+// same — состояние уже такое; возвращает, нужен ли вызов GL
+bool needCall(bool same)
+{
+    if(same) {
+        ++stats.elided;
+        PROFILE_COUNT("GL calls elided", 1);
+        return false;
+    }
+    ++stats.issued;
+    return true;
+}
+
+unsigned int *bufferSlot(Enum target)
+{
+    switch(target) {
+    case GL_ARRAY_BUFFER: return &cache.arrayBuffer;
+    case GL_UNIFORM_BUFFER: return &cache.uniformBuffer;
+    default: return nullptr;
+    }
+}
+
+int *capSlot(Enum cap)
+{
+    switch(cap) {
+    case GL_DEPTH_TEST: return &cache.caps[CAP_DEPTH_TEST];
+    case GL_BLEND: return &cache.caps[CAP_BLEND];
+    case GL_CULL_FACE: return &cache.caps[CAP_CULL_FACE];
+    default: return nullptr;
+    }
+}
+
+void setCap(Enum cap, int on)
+{
+    int *slot = capSlot(cap);
+    if(!needCall(slot && *slot == on)) return;
+    if(slot) *slot = on;
+    if(on) glEnable(cap);
+    else glDisable(cap);
+}
+
+} // namespace
+
+void useProgram(unsigned int program)
+{
+    if(!needCall(cache.program == program)) return;
+    cache.program = program;
+    glUseProgram(program);
+}
+
+void bindVertexArray(unsigned int vao)
+{
+    if(!needCall(cache.vao == vao)) return;
+    cache.vao = vao;
+    glBindVertexArray(vao);
+}
+
+void bindBuffer(Enum target, unsigned int buffer)
+{
+    unsigned int *slot = bufferSlot(target);
+    if(!needCall(slot && *slot == buffer)) return;
+    if(slot) *slot = buffer;
+    glBindBuffer(target, buffer);
+}
+
+void bindBufferBase(Enum target, unsigned int index, unsigned int buffer)
+{
+    needCall(false);
+    if(unsigned int *slot = bufferSlot(target)) *slot = buffer;
+    glBindBufferBase(target, index, buffer);
+}
+
+void viewport(int x, int y, int width, int height)
+{
+    int *v = cache.viewport;
+    if(!needCall(v[0] == x && v[1] == y && v[2] == width && v[3] == height)) return;
+    v[0] = x; v[1] = y; v[2] = width; v[3] = height;
+    glViewport(x, y, width, height);
+}
+
+void enable(Enum cap) { setCap(cap, 1); }
+void disable(Enum cap) { setCap(cap, 0); }
+
+void blendFunc(Enum src, Enum dst)
+{
+    if(!needCall(cache.blendSrc == src && cache.blendDst == dst)) return;
+    cache.blendSrc = src;
+    cache.blendDst = dst;
+    glBlendFunc(src, dst);
+}
+
+void depthMask(bool write)
+{
+    if(!needCall(cache.depthMask == (int)write)) return;
+    cache.depthMask = write;
+    glDepthMask(write ? GL_TRUE : GL_FALSE);
+}
+
+void invalidate()
+{
+    cache = Cache{};
+}
+
+Stats getStats() { return stats; }
+
+} // namespace glstate
@@ -0,0 +1,38 @@
+// GLState.h
+#pragma once
+
+// Кэш состояния GL: программа, VAO, буферы GL_ARRAY_BUFFER / GL_UNIFORM_BUFFER, viewport,
+// depth test / blend / cull face, blend func и depth mask. Вызов, который ничего не меняет,
+// в драйвер не уходит. Один контекст на процесс, всё — из потока рендера.
+//
+// Код, который меняет состояние мимо кэша, должен вернуть его как было (бэкенд ImGui
+// так и делает) или позвать invalidate(). Удалённые объекты забываются через invalidate()
+// (Renderer делает это в деструкторе), иначе переиспользованный id будет считаться привязанным.
+namespace glstate {
+
+// GLenum / GLuint без <glad/glad.h> в заголовке
+using Enum = unsigned int;
+
+void useProgram(unsigned int program);
+void bindVertexArray(unsigned int vao);
+// Кэшируются GL_ARRAY_BUFFER и GL_UNIFORM_BUFFER; остальные цели уходят в GL как есть
+void bindBuffer(Enum target, unsigned int buffer);
+// Всегда вызывается; заодно ставит общую привязку target (так делает glBindBufferBase)
+void bindBufferBase(Enum target, unsigned int index, unsigned int buffer);
+void viewport(int x, int y, int width, int height);
+// GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE кэшируются, остальное — напрямую
+void enable(Enum cap);
+void disable(Enum cap);
+void blendFunc(Enum src, Enum dst);
+void depthMask(bool write);
+
+// Забыть всё: следующий вызов каждого вида уйдёт в GL
+void invalidate();
+
+struct Stats {
+    long long issued;   // ушло в GL
+    long long elided;   // отброшено как повторное
+};
+Stats getStats();
+
+} // namespace glstate
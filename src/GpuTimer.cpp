@@ -0,0 +1,57 @@
+//GpuTimer.cpp
+#include "GpuTimer.h"
+#include <glad/glad.h>
+#include <cstring>
+
+GpuTimer::GpuTimer()
+{
+    if(!GLAD_GL_VERSION_3_3) return;
+    int bits = 0;
+    glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &bits);
+    supported = bits > 0;
+    if(supported)
+        glGenQueries(LATENCY * MAX_PHASES, &queries[0][0]);
+}
+
+GpuTimer::~GpuTimer()
+{
+    if(supported)
+        glDeleteQueries(LATENCY * MAX_PHASES, &queries[0][0]);
+}
+
+void GpuTimer::beginFrame()
+{
+    if(!supported) return;
+    slot = (slot + 1) % LATENCY;
+    // Кадр LATENCY назад почти всегда готов; если нет — подождём, иначе запрос нельзя переиспользовать
+    for(int i = 0; i < phaseCount; ++i) {
+        if(!issued[slot][i]) continue;
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(queries[slot][i], GL_QUERY_RESULT, &ns);
+        ms[i] = ns * 1e-6;
+        issued[slot][i] = false;
+    }
+}
+
+bool GpuTimer::begin(const char *phase)
+{
+    if(!supported || !profiler::isEnabled() || activePhase >= 0) return false;
+    int i = 0;
+    while(i < phaseCount && std::strcmp(names[i], phase)) ++i;
+    if(i == phaseCount) {
+        if(phaseCount == MAX_PHASES) return false;
+        names[phaseCount++] = phase;
+    }
+    if(issued[slot][i]) return false;   // фаза уже была в этом кадре
+    glBeginQuery(GL_TIME_ELAPSED, queries[slot][i]);
+    issued[slot][i] = true;
+    activePhase = i;
+    return true;
+}
+
+void GpuTimer::end()
+{
+    if(activePhase < 0) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    activePhase = -1;
+}
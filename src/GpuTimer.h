@@ -0,0 +1,55 @@
+// GpuTimer.h
+#pragma once
+#include "Profiler.h"
+
+// Время GPU по фазам кадра через запросы GL_TIME_ELAPSED. Результат фазы читается через
+// LATENCY кадров, когда GPU его уже посчитал, поэтому кадр не ждёт GPU.
+// Фазы не вкладываются (ограничение GL_TIME_ELAPSED) и пишутся, только пока включён profiler.
+class GpuTimer {
+public:
+    static const int MAX_PHASES = 8;
+    static const int LATENCY = 4;
+
+    GpuTimer();
+    ~GpuTimer();
+    GpuTimer(const GpuTimer &) = delete;
+    GpuTimer &operator=(const GpuTimer &) = delete;
+
+    // Драйвер может отдавать 0 бит счётчика — тогда таймер ничего не делает
+    bool isSupported() const { return supported; }
+
+    // В начале кадра: забирает результаты кадра LATENCY назад
+    void beginFrame();
+    // false — фаза не пишется (таймер выключен, другая фаза открыта, нет места)
+    bool begin(const char *phase);
+    void end();
+
+    int getPhaseCount() const { return phaseCount; }
+    const char *getPhaseName(int i) const { return names[i]; }
+    double getPhaseMs(int i) const { return ms[i]; }
+
+    class Scope {
+    public:
+        Scope(GpuTimer &timer, const char *phase) : timer(timer), started(timer.begin(phase)) {}
+        ~Scope() { if(started) timer.end(); }
+    private:
+        GpuTimer &timer;
+        bool started;
+    };
+
+private:
+    bool supported = false;
+    unsigned int queries[LATENCY][MAX_PHASES];
+    bool issued[LATENCY][MAX_PHASES] = {};
+    int slot = 0;
+    int phaseCount = 0;
+    int activePhase = -1;
+    const char *names[MAX_PHASES];
+    double ms[MAX_PHASES] = {};
+};
+
+#ifdef TETRIS_PROFILE
+#define PROFILE_GPU_SCOPE(timer, phase) GpuTimer::Scope PROFILE_CONCAT(gpuScope_, __LINE__)(timer, phase)
+#else
+#define PROFILE_GPU_SCOPE(timer, phase) ((void)0)
+#endif
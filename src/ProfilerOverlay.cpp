@@ -0,0 +1,53 @@
+// ProfilerOverlay.cpp
+#include "ProfilerOverlay.h"
+#include <imgui.h>
+#include <cstdio>
+
+void drawProfilerOverlay(const GpuTimer &gpuTimer) {
+    ImGui::SetNextWindowPos({10, 100}, ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize({340, 0}, ImGuiCond_FirstUseEver);
+    if(!ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_NoFocusOnAppearing)) {
+        ImGui::End();
+        return;
+    }
+
+    double avgMs = profiler::getAverageFrameMs();
+    int offset;
+    const float *history = profiler::getFrameHistory(offset);
+    char overlay[48];
+    std::snprintf(overlay, sizeof(overlay), "%.2f ms (%.0f FPS)", avgMs, avgMs > 0.0 ? 1000.0 / avgMs : 0.0);
+    // Шкала до 33 мс: кадры дольше 30 FPS упираются в верх графика
+    ImGui::PlotLines("##frame", history, profiler::HISTORY, offset, overlay, 0.0f, 33.3f, ImVec2(-1, 60));
+
+    if(ImGui::BeginTable("zones", 4)) {
+        ImGui::TableSetupColumn("CPU");
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("avg");
+        ImGui::TableSetupColumn("calls");
+        ImGui::TableHeadersRow();
+        for(int i = 0; i < profiler::getZoneCount(); ++i) {
+            profiler::ZoneStats z = profiler::getZone(i);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%s", z.name);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", z.lastMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", z.avgMs);
+            ImGui::TableNextColumn(); ImGui::Text("%d", z.calls);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+    for(int i = 0; i < profiler::getCounterCount(); ++i) {
+        profiler::CounterStats c = profiler::getCounter(i);
+        ImGui::Text("%-16s %8lld  (avg %.1f)", c.name, (long long)c.last, c.avg);
+    }
+
+    ImGui::Separator();
+    if(!gpuTimer.isSupported()) {
+        ImGui::TextDisabled("GPU timer queries not supported");
+    } else {
+        for(int i = 0; i < gpuTimer.getPhaseCount(); ++i)
+            ImGui::Text("GPU %-12s %8.3f ms", gpuTimer.getPhaseName(i), gpuTimer.getPhaseMs(i));
+    }
+    ImGui::End();
+}
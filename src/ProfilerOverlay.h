@@ -0,0 +1,7 @@
+// ProfilerOverlay.h
+#pragma once
+#include "GpuTimer.h"
+
+// Окно профилировщика: график времени кадра, зоны PROFILE_SCOPE, счётчики
+// PROFILE_COUNT и время GPU по фазам. Зовётся между ImGui::NewFrame и ImGui::Render.
+void drawProfilerOverlay(const GpuTimer &gpuTimer);
@@ -1,12 +1,17 @@
 #include "Renderer.h"
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include "Shader.h"
+#include "GLState.h"
+#include "Profiler.h"
 
 Renderer::Renderer() {
     shader = new Shader("shaders/pbr.vs", "shaders/pbr.fs");
+    initFrameBuffer();
     initCube();
 }
 
@@ -14,6 +19,60 @@ Renderer::~Renderer() {
     delete shader;
     glDeleteVertexArrays(1, &cubeVAO);
     glDeleteBuffers(1, &cubeVBO);
+    glDeleteBuffers(1, &instanceVBO);
+    glDeleteBuffers(1, &frameUBO);
+    for(auto &batch : batches) {
+        glDeleteVertexArrays(1, &batch.vao);
+        glDeleteBuffers(1, &batch.vbo);
+    }
+    glstate::invalidate();   // id удалённых объектов GL может выдать снова
+}
+
+CubeInstance::CubeInstance(const glm::mat4 &model, const glm::vec3 &albedo, float metallic, float roughness)
+    : model(model), normalMatrix(computeNormalMatrix(model)), albedo(albedo), metallic(metallic), roughness(roughness)
+{
+}
+
+glm::mat3 computeNormalMatrix(const glm::mat4 &model)
+{
+    glm::mat3 m(model);
+    const float eps = 1e-5f;
+
+    // Столбцы ортогональны -> достаточно поделить каждый на квадрат длины
+    // (при равном масштабе и это не нужно: нормаль всё равно нормализуется в шейдере)
+    float d01 = glm::dot(m[0], m[1]), d02 = glm::dot(m[0], m[2]), d12 = glm::dot(m[1], m[2]);
+    if(std::fabs(d01) < eps && std::fabs(d02) < eps && std::fabs(d12) < eps) {
+        float l0 = glm::dot(m[0], m[0]), l1 = glm::dot(m[1], m[1]), l2 = glm::dot(m[2], m[2]);
+        if(std::fabs(l0 - l1) < eps * l0 && std::fabs(l0 - l2) < eps * l0)
+            return m;
+        if(l0 > 0.0f && l1 > 0.0f && l2 > 0.0f) {
+            m[0] /= l0;
+            m[1] /= l1;
+            m[2] /= l2;
+            return m;
+        }
+    }
+    // Вырожденная модель (нулевой масштаб — пустые клетки поля): обращать нечего,
+    // inverseTranspose дал бы inf/NaN. Куб схлопнут в точку, нормаль не важна.
+    if(std::fabs(glm::determinant(m)) < 1e-12f)
+        return glm::mat3(0.0f);
+    return glm::inverseTranspose(m);
+}
+
+// Binding point блока FrameData
+static const unsigned int FRAME_BINDING = 0;
+
+void Renderer::initFrameBuffer() {
+    glGenBuffers(1, &frameUBO);
+    glstate::bindBuffer(GL_UNIFORM_BUFFER, frameUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameConstants), nullptr, GL_DYNAMIC_DRAW);
+    glstate::bindBufferBase(GL_UNIFORM_BUFFER, FRAME_BINDING, frameUBO);
+
+    unsigned int blockIndex = glGetUniformBlockIndex(shader->ID, "FrameData");
+    if(blockIndex == GL_INVALID_INDEX)
+        std::cerr << "FrameData uniform block not found in pbr shader\n";
+    else
+        glUniformBlockBinding(shader->ID, blockIndex, FRAME_BINDING);
 }
 
 void Renderer::initCube() {
@@ -62,61 +121,150 @@ void Renderer::initCube() {
         -1.0f,  1.0f, -1.0f,  0.0f, 1.0f,  0.0f
     };
 
-    glGenVertexArrays(1, &cubeVAO);
     glGenBuffers(1, &cubeVBO);
-    glBindVertexArray(cubeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, cubeVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
+    // VAO для кубов, которые заливаются каждый кадр (drawCubes)
+    glGenBuffers(1, &instanceVBO);
+    cubeVAO = createInstancedVAO(instanceVBO);
+}
+
+unsigned int Renderer::createInstancedVAO(unsigned int instanceBuffer)
+{
+    unsigned int vao;
+    glGenVertexArrays(1, &vao);
+    glstate::bindVertexArray(vao);
+
+    glstate::bindBuffer(GL_ARRAY_BUFFER, cubeVBO);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glBindVertexArray(0);
+
+    // Per-instance attributes: mat4 model занимает 4 слота (2..5)
+    glstate::bindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    const GLsizei stride = sizeof(CubeInstance);
+    for(int i = 0; i < 4; ++i) {
+        glEnableVertexAttribArray(2 + i);
+        glVertexAttribPointer(2 + i, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offsetof(CubeInstance, model) + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(2 + i, 1);
+    }
+    glEnableVertexAttribArray(6);
+    glVertexAttribPointer(6, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(CubeInstance, albedo));
+    glVertexAttribDivisor(6, 1);
+    // metallic + roughness идут подряд -> один vec2
+    glEnableVertexAttribArray(7);
+    glVertexAttribPointer(7, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(CubeInstance, metallic));
+    glVertexAttribDivisor(7, 1);
+    // mat3 normalMatrix занимает 3 слота (8..10)
+    for(int i = 0; i < 3; ++i) {
+        glEnableVertexAttribArray(8 + i);
+        glVertexAttribPointer(8 + i, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(offsetof(CubeInstance, normalMatrix) + i * sizeof(glm::vec3)));
+        glVertexAttribDivisor(8 + i, 1);
+    }
+
+    glstate::bindVertexArray(0);
+    return vao;
 }
 
-void Renderer::drawCube(const glm::mat4 &model, const glm::vec3 &albedo,
-                        float metallic, float roughness, const glm::vec3 &camPos)
+int Renderer::createBatch(const CubeInstance *cubes, size_t count, bool dynamic)
+{
+    CubeBatch batch;
+    batch.count = count;
+    glGenBuffers(1, &batch.vbo);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(CubeInstance), cubes, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    batch.vao = createInstancedVAO(batch.vbo);
+    batches.push_back(batch);
+    return (int)batches.size() - 1;
+}
+
+void Renderer::updateBatch(int id, size_t first, const CubeInstance *cubes, size_t count)
+{
+    const CubeBatch &batch = batches[id];
+    if(count == 0 || first + count > batch.count) return;
+
+    PROFILE_SCOPE("buffer upload");
+    PROFILE_COUNT("buffer uploads", 1);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(CubeInstance), count * sizeof(CubeInstance), cubes);
+}
+
+void Renderer::drawBatch(int id)
 {
+    const CubeBatch &batch = batches[id];
+    if(batch.count == 0) return;
+
+    // VAO не отвязывается: следующий draw ставит свой, повторная привязка отбрасывается кэшем
     shader->use();
-    shader->setMat4("model", model);
+    glstate::bindVertexArray(batch.vao);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, (GLsizei)batch.count);
+    PROFILE_COUNT("draw calls", 1);
+    PROFILE_COUNT("instances", batch.count);
+}
 
-    shader->setVec3("objectColor", albedo);
-    shader->setVec3("camPos", camPos);
+void Renderer::uploadInstances(const CubeInstance *cubes, size_t count)
+{
+    PROFILE_SCOPE("buffer upload");
+    PROFILE_COUNT("buffer uploads", 1);
+    glstate::bindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if(count > instanceCapacity) {
+        instanceCapacity = count;
+        glBufferData(GL_ARRAY_BUFFER, count * sizeof(CubeInstance), cubes, GL_STREAM_DRAW);
+    } else {
+        // Orphaning: драйвер отдаёт новый буфер, не дожидаясь предыдущего кадра
+        glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(CubeInstance), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(CubeInstance), cubes);
+    }
+}
+
+void Renderer::beginFrame(const glm::mat4 &view, const glm::mat4 &projection, const glm::vec3 &camPos)
+{
+    FrameConstants frame;
+    frame.view = view;
+    frame.projection = projection;
+    frame.camPos = glm::vec4(camPos, 1.0f);
+
+    // Lights (осветлил!)
+    frame.lightPositions[0] = glm::vec4(10, 10, 10, 1);
+    frame.lightPositions[1] = glm::vec4(-10, 10, 5, 1);
+    frame.lightColors[0] = glm::vec4(20.0f, 20.0f, 20.0f, 0.0f);
+    frame.lightColors[1] = glm::vec4(12.0f, 10.0f, 8.0f, 0.0f);
 
-    shader->setFloat("metallic", metallic);
-    shader->setFloat("roughness", roughness);
+    // Fog
+    frame.fogColor = glm::vec4(0.1f, 0.3f, 0.45f, 1.0f);
+    frame.fogParams = glm::vec4(15.0f, 45.0f, 0.0f, 0.0f);
 
     // Glow
-    shader->setFloat("emissionStrength", 0.3f);
-    shader->setVec3("emissionColor", glm::vec3(1.0, 0.9, 0.8));
+    frame.emission = glm::vec4(1.0f, 0.9f, 0.8f, 0.3f);
 
     // Fade-in (будет управляться из Game)
-    shader->setFloat("fade", currentFadeValue);//currentFadeValue is red
+    frame.misc = glm::vec4(currentFadeValue, 0.0f, 0.0f, 0.0f);
 
-    // Fog
-    shader->setInt("useFog", 1);
-    shader->setVec3("fogColor", glm::vec3(0.1f, 0.3f, 0.45f));
-    shader->setFloat("fogNear", 15.0f);
-    shader->setFloat("fogFar", 45.0f);
+    glstate::bindBuffer(GL_UNIFORM_BUFFER, frameUBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameConstants), &frame);
+    PROFILE_COUNT("uniform uploads", 1);
+}
 
-    // Lights (осветлил!)
-    glm::vec3 lightPositions[2] = {
-        glm::vec3(10, 10, 10),
-        glm::vec3(-10, 10, 5)
-    };
-    glm::vec3 lightColors[2] = {
-        glm::vec3(20.0f),
-        glm::vec3(12.0f, 10.0f, 8.0f)
-    };
+void Renderer::drawCube(const glm::mat4 &model, const glm::vec3 &albedo,
+                        float metallic, float roughness)
+{
+    CubeInstance cube{model, albedo, metallic, roughness};
+    drawCubes(&cube, 1);
+}
 
-    shader->setVec3("lightPositions[0]", lightPositions[0]);
-    shader->setVec3("lightColors[0]", lightColors[0]);
+void Renderer::drawCubes(const CubeInstance *cubes, size_t count)
+{
+    if(count == 0) return;
 
-    shader->setVec3("lightPositions[1]", lightPositions[1]);
-    shader->setVec3("lightColors[1]", lightColors[1]);
+    shader->use();
+    uploadInstances(cubes, count);
 
-    glBindVertexArray(cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+    glstate::bindVertexArray(cubeVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, (GLsizei)count);
+    PROFILE_COUNT("draw calls", 1);
+    PROFILE_COUNT("instances", count);
 }
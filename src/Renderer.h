@@ -1,17 +1,76 @@
 //Renderer.h
 #pragma once
 #include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
 #include "Shader.h"
 
+// Данные одного куба для инстансинга (атрибуты 2..10 в pbr.vs)
+struct CubeInstance {
+    glm::mat4 model;
+    glm::mat3 normalMatrix;   // считается на CPU, см. computeNormalMatrix
+    glm::vec3 albedo;
+    float metallic;
+    float roughness;
+
+    CubeInstance() = default;
+    CubeInstance(const glm::mat4 &model, const glm::vec3 &albedo, float metallic, float roughness);
+};
+
+// transpose(inverse(mat3(model))); для равномерного масштаба и осевого
+// масштаба обходится без обращения матрицы; для вырожденной модели — нулевая матрица
+glm::mat3 computeNormalMatrix(const glm::mat4 &model);
+
+// Константы кадра: std140-раскладка блока FrameData в pbr.vs/pbr.fs
+struct FrameConstants {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec4 camPos;            // xyz
+    glm::vec4 lightPositions[2]; // xyz
+    glm::vec4 lightColors[2];    // rgb
+    glm::vec4 fogColor;          // rgb, w = useFog
+    glm::vec4 fogParams;         // x = near, y = far
+    glm::vec4 emission;          // rgb = color, w = strength
+    glm::vec4 misc;              // x = fade
+};
+
 class Renderer {
 public:
     Renderer();
     ~Renderer();
-    void drawCube(const glm::mat4 &model, const glm::vec3 &albedo, float metallic, float roughness, const glm::vec3 &camPos);
+    // Один раз за кадр: камера, свет и туман уходят в uniform buffer
+    void beginFrame(const glm::mat4 &view, const glm::mat4 &projection, const glm::vec3 &camPos);
+    void drawCube(const glm::mat4 &model, const glm::vec3 &albedo, float metallic, float roughness);
+    // Все кубы рисуются одним glDrawArraysInstanced
+    void drawCubes(const CubeInstance *cubes, size_t count);
+    void drawCubes(const std::vector<CubeInstance> &cubes) { drawCubes(cubes.data(), cubes.size()); }
+
+    // Постоянный набор кубов в своём VBO, рисуется одним вызовом.
+    // Возвращает id для drawBatch; буферы освобождаются в ~Renderer.
+    // dynamic = true для наборов, которые частично обновляются через updateBatch.
+    int createBatch(const CubeInstance *cubes, size_t count, bool dynamic = false);
+    int createBatch(const std::vector<CubeInstance> &cubes, bool dynamic = false) { return createBatch(cubes.data(), cubes.size(), dynamic); }
+    // Перезаписывает инстансы [first, first + count) без переразметки буфера
+    void updateBatch(int id, size_t first, const CubeInstance *cubes, size_t count);
+    void drawBatch(int id);
+
     Shader* getShader() { return shader; }
     float currentFadeValue = 0.5f;
 private:
+    struct CubeBatch {
+        unsigned int vao = 0, vbo = 0;
+        size_t count = 0;
+    };
+
     unsigned int cubeVAO, cubeVBO;
+    unsigned int instanceVBO;
+    size_t instanceCapacity = 0;   // в инстансах
+    unsigned int frameUBO;
     Shader* shader;
+    std::vector<CubeBatch> batches;
+
     void initCube();
+    unsigned int createInstancedVAO(unsigned int instanceBuffer);
+    void initFrameBuffer();
+    void uploadInstances(const CubeInstance *cubes, size_t count);
 };
@@ -4,6 +4,8 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include "GLState.h"
+#include "Profiler.h"
 
 Shader::Shader(const char* vertexPath, const char* fragmentPath)
 {
@@ -54,12 +56,56 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath)
     }
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    cacheUniformLocations();
+}
+
+void Shader::cacheUniformLocations()
+{
+    int count = 0, maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::string name(maxLength, '\0');
+
+    for(int i = 0; i < count; ++i){
+        int length = 0, size = 0;
+        GLenum type;
+        glGetActiveUniform(ID, i, maxLength, &length, &size, &type, &name[0]);
+        std::string uniformName(name.data(), length);
+        int location = glGetUniformLocation(ID, uniformName.c_str());
+        if(location < 0) continue; // uniform из блока
+
+        uniformLocations[uniformName] = location;
+
+        // Массив: драйвер отдаёт "name[0]", регистрируем "name" и все элементы
+        size_t bracket = uniformName.find('[');
+        if(bracket != std::string::npos){
+            std::string base = uniformName.substr(0, bracket);
+            uniformLocations[base] = location;
+            for(int e = 1; e < size; ++e){
+                std::string element = base + "[" + std::to_string(e) + "]";
+                uniformLocations[element] = glGetUniformLocation(ID, element.c_str());
+            }
+        }
+    }
+}
+
+void Shader::use() const { glstate::useProgram(ID); }
+
+int Shader::getUniformLocation(const std::string &name) const
+{
+    auto it = uniformLocations.find(name);
+    return it != uniformLocations.end() ? it->second : -1;
 }
 
-void Shader::use() const { glUseProgram(ID); }
+void Shader::setBool(const std::string &name, bool value) const { setBool(getUniformLocation(name), value); }
+void Shader::setInt(const std::string &name, int value) const { setInt(getUniformLocation(name), value); }
+void Shader::setFloat(const std::string &name, float value) const { setFloat(getUniformLocation(name), value); }
+void Shader::setVec3(const std::string &name, const glm::vec3 &value) const { setVec3(getUniformLocation(name), value); }
+void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const { setMat4(getUniformLocation(name), mat); }
 
-void Shader::setBool(const std::string &name, bool value) const { glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value); }
-void Shader::setInt(const std::string &name, int value) const { glUniform1i(glGetUniformLocation(ID, name.c_str()), value); }
-void Shader::setFloat(const std::string &name, float value) const { glUniform1f(glGetUniformLocation(ID, name.c_str()), value); }
-void Shader::setVec3(const std::string &name, const glm::vec3 &value) const { glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]); }
-void Shader::setMat4(const std::string &name, const glm::mat4 &mat) const { glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]); }
+void Shader::setBool(int location, bool value) const { glUniform1i(location, (int)value); PROFILE_COUNT("uniform uploads", 1); }
+void Shader::setInt(int location, int value) const { glUniform1i(location, value); PROFILE_COUNT("uniform uploads", 1); }
+void Shader::setFloat(int location, float value) const { glUniform1f(location, value); PROFILE_COUNT("uniform uploads", 1); }
+void Shader::setVec3(int location, const glm::vec3 &value) const { glUniform3fv(location, 1, &value[0]); PROFILE_COUNT("uniform uploads", 1); }
+void Shader::setMat4(int location, const glm::mat4 &mat) const { glUniformMatrix4fv(location, 1, GL_FALSE, &mat[0][0]); PROFILE_COUNT("uniform uploads", 1); }
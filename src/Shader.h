@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
 class Shader {
@@ -7,9 +8,23 @@ public:
     unsigned int ID;
     Shader(const char* vertexPath, const char* fragmentPath);
     void use() const;
+
+    // Location из кэша, заполненного при линковке (-1 если uniform не активен)
+    int getUniformLocation(const std::string &name) const;
+
     void setBool(const std::string &name, bool value) const;
     void setInt(const std::string &name, int value) const;
     void setFloat(const std::string &name, float value) const;
     void setVec3(const std::string &name, const glm::vec3 &value) const;
     void setMat4(const std::string &name, const glm::mat4 &mat) const;
+
+    // Быстрый путь: location заранее получен через getUniformLocation
+    void setBool(int location, bool value) const;
+    void setInt(int location, int value) const;
+    void setFloat(int location, float value) const;
+    void setVec3(int location, const glm::vec3 &value) const;
+    void setMat4(int location, const glm::mat4 &mat) const;
+private:
+    std::unordered_map<std::string, int> uniformLocations;
+    void cacheUniformLocations();
 };
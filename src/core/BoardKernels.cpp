@@ -0,0 +1,328 @@
+//BoardKernels.cpp
+#include "BoardKernels.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TETRIS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TETRIS_TARGET_AVX2
+#else
+#define TETRIS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+int popcount64(uint64_t x)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    return (int)__popcnt64(x);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    return (int)(__popcnt((unsigned)x) + __popcnt((unsigned)(x >> 32)));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+int bitLength64(uint64_t x)
+{
+    if(x == 0) return 0;
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return (int)index + 1;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    if(x >> 32) { _BitScanReverse(&index, (unsigned long)(x >> 32)); return (int)index + 33; }
+    _BitScanReverse(&index, (unsigned long)x);
+    return (int)index + 1;
+#else
+    return 64 - __builtin_clzll(x);
+#endif
+}
+
+namespace {
+
+template<typename Row>
+struct RowKernels {
+    uint64_t (*fullRows)(const Row *rows, int height, Row fullRow);
+    void (*columnMasks)(const Row *rows, int height, int width, uint64_t *cols);
+};
+
+// ---------------------------------------------------------------- scalar
+
+template<typename Row>
+uint64_t fullRowsScalar(const Row *rows, int height, Row fullRow)
+{
+    uint64_t mask = 0;
+    for(int y = 0; y < height; ++y)
+        mask |= (uint64_t)(rows[y] == fullRow) << y;
+    return mask;
+}
+
+template<typename Row>
+void columnMasksScalar(const Row *rows, int height, int width, uint64_t *cols)
+{
+    for(int x = 0; x < width; ++x) cols[x] = 0;
+    for(int y = 0; y < height; ++y)
+        for(int x = 0; x < width; ++x)
+            cols[x] |= (uint64_t)((rows[y] >> x) & 1u) << y;
+}
+
+#ifdef TETRIS_X86
+
+// ---------------------------------------------------------------- SSE2
+// Полные строки: сравнение по 8 (uint16) или 2 (uint64) строки за раз.
+// Колонки: сдвиг влево ставит бит x в знаковый бит каждой строки, movemask
+// собирает знаковые биты — получается кусок маски колонки.
+// Неполный последний вектор читается из обнулённой копии: лишние строки пустые,
+// в маску колонок они ничего не добавляют, а из маски строк отрезаются.
+
+inline uint64_t lowRows(int height)
+{
+    return height >= 64 ? ~0ull : (1ull << height) - 1;
+}
+
+template<int N, typename Row>
+inline const Row *rowBlock(const Row *rows, int y, int height, Row (&tail)[N])
+{
+    if(y + N <= height) return rows + y;
+    std::memset(tail, 0, sizeof(tail));
+    std::memcpy(tail, rows + y, sizeof(Row) * (height - y));
+    return tail;
+}
+
+uint64_t fullRowsSse2(const uint16_t *rows, int height, uint16_t fullRow)
+{
+    const __m128i full = _mm_set1_epi16((short)fullRow);
+    uint64_t mask = 0;
+    for(int y = 0; y < height; y += 8) {
+        uint16_t tail[8];
+        __m128i v = _mm_loadu_si128((const __m128i *)rowBlock(rows, y, height, tail));
+        __m128i eq = _mm_packs_epi16(_mm_cmpeq_epi16(v, full), _mm_setzero_si128());
+        mask |= (uint64_t)(_mm_movemask_epi8(eq) & 0xFF) << y;
+    }
+    return mask & lowRows(height);
+}
+
+void columnMasksSse2(const uint16_t *rows, int height, int width, uint64_t *cols)
+{
+    for(int x = 0; x < width; ++x) cols[x] = 0;
+    for(int y = 0; y < height; y += 8) {
+        uint16_t tail[8];
+        __m128i v = _mm_loadu_si128((const __m128i *)rowBlock(rows, y, height, tail));
+        for(int x = 0; x < width; ++x) {
+            __m128i t = _mm_sll_epi16(v, _mm_cvtsi32_si128(15 - x));
+            cols[x] |= (uint64_t)(_mm_movemask_epi8(_mm_packs_epi16(t, t)) & 0xFF) << y;
+        }
+    }
+}
+
+uint64_t fullRowsSse2(const uint64_t *rows, int height, uint64_t fullRow)
+{
+    const __m128i full = _mm_set1_epi64x((long long)fullRow);
+    uint64_t mask = 0;
+    for(int y = 0; y < height; y += 2) {
+        uint64_t tail[2];
+        __m128i v = _mm_loadu_si128((const __m128i *)rowBlock(rows, y, height, tail));
+        // В SSE2 нет сравнения 64-битных слов: обе 32-битные половины должны совпасть
+        __m128i eq32 = _mm_cmpeq_epi32(v, full);
+        __m128i eq = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+        mask |= (uint64_t)_mm_movemask_pd(_mm_castsi128_pd(eq)) << y;
+    }
+    return mask & lowRows(height);
+}
+
+void columnMasksSse2(const uint64_t *rows, int height, int width, uint64_t *cols)
+{
+    for(int x = 0; x < width; ++x) cols[x] = 0;
+    for(int y = 0; y < height; y += 2) {
+        uint64_t tail[2];
+        __m128i v = _mm_loadu_si128((const __m128i *)rowBlock(rows, y, height, tail));
+        for(int x = 0; x < width; ++x) {
+            __m128i t = _mm_sll_epi64(v, _mm_cvtsi32_si128(63 - x));
+            cols[x] |= (uint64_t)_mm_movemask_pd(_mm_castsi128_pd(t)) << y;
+        }
+    }
+}
+
+// ---------------------------------------------------------------- AVX2
+
+// packs_epi16 в AVX2 работает по 128-битным половинам: байты строк 0..7
+// оказываются в битах 0..7 маски, строк 8..15 — в битах 16..23
+TETRIS_TARGET_AVX2 inline uint32_t packRowBits16(__m256i v)
+{
+    uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_packs_epi16(v, _mm256_setzero_si256()));
+    return (m & 0xFFu) | ((m >> 8) & 0xFF00u);
+}
+
+TETRIS_TARGET_AVX2 uint64_t fullRowsAvx2(const uint16_t *rows, int height, uint16_t fullRow)
+{
+    const __m256i full = _mm256_set1_epi16((short)fullRow);
+    uint64_t mask = 0;
+    for(int y = 0; y < height; y += 16) {
+        uint16_t tail[16];
+        __m256i v = _mm256_loadu_si256((const __m256i *)rowBlock(rows, y, height, tail));
+        mask |= (uint64_t)packRowBits16(_mm256_cmpeq_epi16(v, full)) << y;
+    }
+    return mask & lowRows(height);
+}
+
+TETRIS_TARGET_AVX2 void columnMasksAvx2(const uint16_t *rows, int height, int width, uint64_t *cols)
+{
+    for(int x = 0; x < width; ++x) cols[x] = 0;
+    for(int y = 0; y < height; y += 16) {
+        uint16_t tail[16];
+        __m256i v = _mm256_loadu_si256((const __m256i *)rowBlock(rows, y, height, tail));
+        for(int x = 0; x < width; ++x) {
+            __m256i t = _mm256_sll_epi16(v, _mm_cvtsi32_si128(15 - x));
+            cols[x] |= (uint64_t)packRowBits16(t) << y;
+        }
+    }
+}
+
+TETRIS_TARGET_AVX2 uint64_t fullRowsAvx2(const uint64_t *rows, int height, uint64_t fullRow)
+{
+    const __m256i full = _mm256_set1_epi64x((long long)fullRow);
+    uint64_t mask = 0;
+    for(int y = 0; y < height; y += 4) {
+        uint64_t tail[4];
+        __m256i v = _mm256_loadu_si256((const __m256i *)rowBlock(rows, y, height, tail));
+        __m256i eq = _mm256_cmpeq_epi64(v, full);
+        mask |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(eq)) << y;
+    }
+    return mask & lowRows(height);
+}
+
+TETRIS_TARGET_AVX2 void columnMasksAvx2(const uint64_t *rows, int height, int width, uint64_t *cols)
+{
+    for(int x = 0; x < width; ++x) cols[x] = 0;
+    for(int y = 0; y < height; y += 4) {
+        uint64_t tail[4];
+        __m256i v = _mm256_loadu_si256((const __m256i *)rowBlock(rows, y, height, tail));
+        for(int x = 0; x < width; ++x) {
+            __m256i t = _mm256_sll_epi64(v, _mm_cvtsi32_si128(63 - x));
+            cols[x] |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(t)) << y;
+        }
+    }
+}
+
+#endif // TETRIS_X86
+
+// ---------------------------------------------------------------- dispatch
+
+SimdLevel &currentLevel()
+{
+    static SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+template<typename Row>
+RowKernels<Row> kernelsFor(SimdLevel level)
+{
+#ifdef TETRIS_X86
+    if(level == SimdLevel::AVX2) return {fullRowsAvx2, columnMasksAvx2};
+    if(level == SimdLevel::SSE2) return {fullRowsSse2, columnMasksSse2};
+#endif
+    (void)level;
+    return {fullRowsScalar<Row>, columnMasksScalar<Row>};
+}
+
+template<typename Row>
+RowKernels<Row> &rowKernels()
+{
+    static RowKernels<Row> kernels = kernelsFor<Row>(currentLevel());
+    return kernels;
+}
+
+} // namespace
+
+SimdLevel detectSimdLevel()
+{
+#ifdef TETRIS_X86
+    if(std::getenv("TETRIS_NO_SIMD")) return SimdLevel::Scalar;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] >= 7) {
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        if(avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6) return SimdLevel::AVX2;
+    }
+#else
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::SSE2;   // SSE2 есть на любом x86-64
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel getSimdLevel() { return currentLevel(); }
+
+void setSimdLevel(SimdLevel level)
+{
+    if((int)level > (int)detectSimdLevel()) level = detectSimdLevel();
+    currentLevel() = level;
+    rowKernels<uint16_t>() = kernelsFor<uint16_t>(level);
+    rowKernels<uint64_t>() = kernelsFor<uint64_t>(level);
+}
+
+const char *simdLevelName(SimdLevel level)
+{
+    switch(level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::Scalar: return "scalar";
+    }
+    return "?";
+}
+
+template<typename Row>
+uint64_t findFullRows(const Row *rows, int height, Row fullRow)
+{
+    return rowKernels<Row>().fullRows(rows, height, fullRow);
+}
+
+template<typename Row>
+uint64_t findEmptyRows(const Row *rows, int height)
+{
+    return rowKernels<Row>().fullRows(rows, height, Row(0));
+}
+
+template<typename Row>
+void columnMasks(const Row *rows, int height, int width, uint64_t *cols)
+{
+    rowKernels<Row>().columnMasks(rows, height, width, cols);
+}
+
+template<typename Row>
+void analyzeBoard(const Row *rows, int height, int width, BoardFeatures &out)
+{
+    uint64_t cols[KERNEL_MAX_WIDTH];
+    rowKernels<Row>().columnMasks(rows, height, width, cols);
+
+    out.maxHeight = out.aggregateHeight = out.holes = out.bumpiness = 0;
+    for(int x = 0; x < width; ++x) {
+        int h = bitLength64(cols[x]);
+        uint64_t below = h == 64 ? ~0ull : ((1ull << h) - 1);
+        out.heights[x] = h;
+        out.holes += h - popcount64(cols[x] & below);
+        out.aggregateHeight += h;
+        if(h > out.maxHeight) out.maxHeight = h;
+        if(x > 0) out.bumpiness += std::abs(h - out.heights[x - 1]);
+    }
+}
+
+template uint64_t findFullRows<uint16_t>(const uint16_t *, int, uint16_t);
+template uint64_t findFullRows<uint64_t>(const uint64_t *, int, uint64_t);
+template uint64_t findEmptyRows<uint16_t>(const uint16_t *, int);
+template uint64_t findEmptyRows<uint64_t>(const uint64_t *, int);
+template void columnMasks<uint16_t>(const uint16_t *, int, int, uint64_t *);
+template void columnMasks<uint64_t>(const uint64_t *, int, int, uint64_t *);
+template void analyzeBoard<uint16_t>(const uint16_t *, int, int, BoardFeatures &);
+template void analyzeBoard<uint64_t>(const uint64_t *, int, int, BoardFeatures &);
@@ -0,0 +1,41 @@
+// BoardKernels.h
+#pragma once
+#include <cstdint>
+
+// Векторные ядра для анализа поля, заданного масками строк (бит x = колонка x).
+// Реализации SSE2 / AVX2 / скалярная выбираются один раз при первом вызове
+// по возможностям процессора (потокобезопасно). Поддерживаются строки uint16_t (до 16 колонок)
+// и uint64_t (до 64 колонок); высота поля — до 64 строк.
+
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+SimdLevel detectSimdLevel();
+SimdLevel getSimdLevel();
+// Принудительно понизить уровень (для сравнения в бенчмарках); выше доступного не поднимается.
+// Только при старте, до первого вызова ядер из других потоков: указатели на реализации
+// меняются без синхронизации
+void setSimdLevel(SimdLevel level);
+const char *simdLevelName(SimdLevel level);
+
+static const int KERNEL_MAX_HEIGHT = 64;
+static const int KERNEL_MAX_WIDTH = 64;
+
+// Признаки поля для оценки позиции ботами
+struct BoardFeatures {
+    int heights[KERNEL_MAX_WIDTH];  // высота каждой колонки (0 — пустая)
+    int maxHeight;
+    int aggregateHeight;            // сумма высот
+    int holes;                      // пустые клетки под верхней занятой в колонке
+    int bumpiness;                  // сумма |h[x] - h[x-1]|
+};
+
+// Бит y результата — строка y полностью занята / пуста
+template<typename Row> uint64_t findFullRows(const Row *rows, int height, Row fullRow);
+template<typename Row> uint64_t findEmptyRows(const Row *rows, int height);
+// Транспонирование: cols[x], бит y = клетка (x, y)
+template<typename Row> void columnMasks(const Row *rows, int height, int width, uint64_t *cols);
+template<typename Row> void analyzeBoard(const Row *rows, int height, int width, BoardFeatures &out);
+
+// Количество единичных битов и позиция старшего бита + 1 (0 для x == 0)
+int popcount64(uint64_t x);
+int bitLength64(uint64_t x);
@@ -0,0 +1,13 @@
+// CoreProfile.h
+#pragma once
+
+// Зоны профилировщика в правилах игры. Обычный tetris_core собирается без них:
+// CORE_PROFILE_SCOPE — пустой макрос, tetris_batch и tetris_bench меряют движок без
+// накладных расходов и не тянут src/profiler. Игра и tetris_render_bench линкуют
+// tetris_core_profiled — те же исходники с TETRIS_CORE_PROFILE, где это PROFILE_SCOPE.
+#ifdef TETRIS_CORE_PROFILE
+#include "Profiler.h"
+#define CORE_PROFILE_SCOPE(name) PROFILE_SCOPE(name)
+#else
+#define CORE_PROFILE_SCOPE(name) ((void)0)
+#endif
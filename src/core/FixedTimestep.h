@@ -0,0 +1,37 @@
+// FixedTimestep.h
+#pragma once
+#include <cmath>
+
+// Симуляция с фиксированным шагом: кадры приходят с любым dt, а Game::update
+// всегда получает один и тот же step, поэтому гравитация не зависит от FPS
+// и партия воспроизводится тик в тик.
+class FixedTimestep {
+public:
+    explicit FixedTimestep(float ticksPerSecond = 60.0f, int maxTicksPerFrame = 8)
+        : step(1.0 / ticksPerSecond), maxTicks(maxTicksPerFrame) {}
+
+    // Добавляет время кадра и возвращает, сколько тиков нужно выполнить.
+    // После долгого кадра догоняем не больше maxTicks, остальное время отбрасываем.
+    int advance(double frameDt)
+    {
+        accumulator += frameDt;
+        int ticks = (int)(accumulator / step);
+        if(ticks > maxTicks) {
+            ticks = maxTicks;
+            accumulator = std::fmod(accumulator, step);
+        } else {
+            accumulator -= ticks * step;
+        }
+        return ticks;
+    }
+
+    float getStep() const { return (float)step; }
+    // Доля пути к следующему тику [0, 1) — для интерполяции при рендере
+    float getAlpha() const { return (float)(accumulator / step); }
+    void reset() { accumulator = 0.0; }
+
+private:
+    double step;
+    int maxTicks;
+    double accumulator = 0.0;
+};
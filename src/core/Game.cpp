@@ -0,0 +1,292 @@
+//Game.cpp
+#include "Game.h"
+#include "BoardKernels.h"
+#include "CoreProfile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace game_detail {
+
+uint64_t randomSeed()
+{
+    std::random_device rd;
+    return ((uint64_t)rd() << 32) ^ rd();
+}
+
+PieceGenerator makeGenerator(uint64_t seed, GeneratorMode mode)
+{
+    // Последовательность из seed не построить: её задают через PieceGenerator::sequence.
+    // Ошибка вызывающего кода, и в release тоже: подмена на 7-bag молча испортила бы партию
+    if(mode == GeneratorMode::Sequence) {
+        std::fprintf(stderr, "GeneratorMode::Sequence needs PieceGenerator::sequence\n");
+        std::abort();
+    }
+    return mode == GeneratorMode::Random ? PieceGenerator::random(seed) : PieceGenerator::bag7(seed);
+}
+
+// Сдвиг строк над снятыми: first — нижняя снятая, full — бит k = строка first + k полная.
+// W, H = DYNAMIC_SIZE — размеры из аргументов; иначе константы, и копирование строк разворачивается
+template<int W, int H, typename Row>
+int compactRows(Row *rows, uint8_t *grid, int width, int height, int first, uint64_t full)
+{
+    const int w = W ? W : width;
+    const int h = H ? H : height;
+    // Один проход снизу вверх: строка копируется сразу на итоговое место,
+    // dst не двигается на полных строках (их перезапишет следующая)
+    int dst = first;
+    for(int y = first + 1; y < h; ++y){
+        rows[dst] = rows[y];
+        std::copy_n(&grid[y * w], w, &grid[dst * w]);
+        dst += !(y - first < 4 && ((full >> (y - first)) & 1));
+    }
+    std::fill(rows + dst, rows + h, 0);
+    std::fill(grid + dst * w, grid + h * w, 0);
+    return dst;
+}
+
+template<int W, int H>
+int BoardStorage<W, H>::compact(int first, uint64_t full)
+{
+    return compactRows<W, H>(rows.data(), grid.data(), W, H, first, full);
+}
+
+BoardStorage<DYNAMIC_SIZE, DYNAMIC_SIZE>::BoardStorage(int width, int height)
+    : w(std::min(std::max(width, 4), 64)), h(std::min(std::max(height, 4), 64))
+{
+    full = w == 64 ? ~0ull : (1ull << w) - 1;
+    rows.assign(h + ROW_PADDING, 0);
+    grid.assign(w * h, 0);
+
+    if(w == 10 && h == 20) compactFn = compactRows<10, 20, Row>;
+    else if(w == 10 && h == 40) compactFn = compactRows<10, 40, Row>;
+    else compactFn = compactRows<DYNAMIC_SIZE, DYNAMIC_SIZE, Row>;
+}
+
+} // namespace game_detail
+
+template<int W, int H>
+BasicGame<W, H>::BasicGame(int width, int height, const PieceGenerator &generator, InitTag)
+    : state(width, height, generator), fallInterval(0.7f)
+{
+    dirtyLast = state.board.height() - 1;
+    spawnRandom();
+}
+
+template<int W, int H>
+void BasicGame<W, H>::reset(const PieceGenerator &generator)
+{
+    state.board.clear();
+    state.active = Piece{};
+    state.generator = generator;
+    state.fallTimer = 0.0f;
+    state.gameOver = false;
+    state.score = state.totalLines = state.piecesPlaced = 0;
+    state.lastClear = LineClear{};
+    dirtyFirst = 0;
+    dirtyLast = state.board.height() - 1;
+    spawnRandom();
+}
+
+template<int W, int H>
+void BasicGame<W, H>::restore(const State &saved)
+{
+    state = saved;
+    dirtyFirst = 0;   // размер поля BasicGame<> мог смениться
+    dirtyLast = state.board.height() - 1;
+}
+
+template<int W, int H>
+Piece BasicGame<W, H>::makePiece(int type, int rotation) const
+{
+    Piece p;
+    p.type = type;
+    p.rotation = rotation & 3;
+    p.x = (state.board.width() - TETROMINO_BOX[type]) / 2;          // Центрирование
+    p.y = state.board.height() - 1 - TETROMINOES[type][0].minY;     // Нижние клетки — в верхней строке поля
+    return p;
+}
+
+template<int W, int H>
+void BasicGame<W, H>::spawnRandom()
+{
+    state.active = makePiece(state.generator.next(), 0);
+
+    // Проверка Game Over
+    // (без вывода в консоль: ядро гоняется в много потоков, GUI показывает свой попап)
+    if(checkCollision(state.active)) {
+        state.gameOver = true;
+    }
+}
+
+template<int W, int H> void BasicGame<W, H>::rotate() { rotateBy(1); }
+template<int W, int H> void BasicGame<W, H>::rotateCCW() { rotateBy(3); }
+template<int W, int H> void BasicGame<W, H>::rotate180() { rotateBy(2); }
+
+template<int W, int H>
+void BasicGame<W, H>::rotateBy(int turns)
+{
+    if(state.gameOver) return;
+
+    // SRS: пробуем сдвиги из таблицы по порядку, если ни один не подошёл - откат
+    int to = (state.active.rotation + turns) & 3;
+    const KickList &kicks = srsKicks(state.active.type, state.active.rotation, to);
+    const TetrominoShape &shape = TETROMINOES[state.active.type][to];
+    for(int i = 0; i < kicks.count; ++i) {
+        int x = state.active.x + kicks.offsets[i].x;
+        int y = state.active.y + kicks.offsets[i].y;
+        if(!collides(shape, x, y)) {
+            state.active.rotation = to;
+            state.active.x = x;
+            state.active.y = y;
+            return;
+        }
+    }
+}
+
+template<int W, int H>
+bool BasicGame<W, H>::applyPlacement(const Placement& placement)
+{
+    if(state.gameOver) return false;
+
+    Piece p = makePiece(state.active.type, placement.rotation);
+    p.x = placement.x;
+    p.y = placement.y;
+    if(checkCollision(p)) return false;
+
+    // Фигура должна лежать на опоре
+    Piece below = p;
+    below.y -= 1;
+    if(!checkCollision(below)) return false;
+
+    state.active = p;
+    lockPiece();
+    return true;
+}
+
+template<int W, int H>
+void BasicGame<W, H>::lockPiece()
+{
+    CORE_PROFILE_SCOPE("lockPiece");
+    for(auto &c : state.active.cells()){
+        int gx = state.active.x + c.x;
+        int gy = state.active.y + c.y;
+
+        // Проверяем, не выходит ли за пределы
+        if(gy >= 0 && gy < state.board.height() && gx >= 0 && gx < state.board.width()) {
+            state.board.grid[gy * state.board.width() + gx] = (uint8_t)state.active.colorIndex();
+            state.board.rows[gy] |= (Row)((Row)1 << gx);
+            markDirty(gy, gy);
+        }
+    }
+    state.piecesPlaced++;
+    clearLines();
+    spawnRandom();
+}
+
+template<int W, int H>
+void BasicGame<W, H>::clearLines()
+{
+    CORE_PROFILE_SCOPE("clearLines");
+    state.lastClear = LineClear{};
+
+    // Заполниться могли только строки, которых коснулась фигура
+    const TetrominoShape &shape = state.active.shape();
+    int lo = std::max(state.active.y + shape.minY, 0);
+    int hi = std::min(state.active.y + shape.maxY, state.board.height() - 1);
+    if(hi < lo) return;
+    // Не больше 4 строк: прямое сравнение дешевле вызова findFullRows через диспетчер
+    // (ядра — для анализа всего поля)
+    const Row fullRow = state.board.fullRow();
+    uint64_t full = 0;
+    for(int y = lo; y <= hi; ++y)
+        full |= (uint64_t)(state.board.rows[y] == fullRow) << (y - lo);
+    if(full == 0) return;
+    for(uint64_t m = full; m; m &= m - 1)
+        state.lastClear.rows[state.lastClear.count++] = lo + bitLength64(m & (~m + 1)) - 1;
+
+    int first = state.lastClear.rows[0];
+    state.board.compact(first, full >> (first - lo));
+    markDirty(first, state.board.height() - 1); // все строки выше сдвинулись
+
+    state.totalLines += state.lastClear.count;
+    state.score += state.lastClear.count * 100;  // Simple scoring: 100 per line
+}
+
+template<int W, int H>
+void BasicGame<W, H>::markDirty(int first, int last)
+{
+    dirtyFirst = std::min(dirtyFirst, first);
+    dirtyLast = std::max(dirtyLast, last);
+}
+
+template<int W, int H>
+bool BasicGame<W, H>::getDirtyRows(int &first, int &last) const
+{
+    if(dirtyFirst > dirtyLast) return false;
+    first = dirtyFirst;
+    last = dirtyLast;
+    return true;
+}
+
+template<int W, int H>
+void BasicGame<W, H>::update(float dt)
+{
+    if(state.gameOver) return;
+
+    state.fallTimer += dt;
+    if(state.fallTimer >= fallInterval){
+        state.fallTimer -= fallInterval; // остаток не теряем, иначе гравитация зависит от dt
+        Piece moved = state.active;
+        moved.y -= 1;
+        if(!checkCollision(moved)){
+            state.active = moved;
+        } else {
+            lockPiece();
+        }
+    }
+}
+
+template<int W, int H>
+void BasicGame<W, H>::moveLeft()
+{
+    if(state.gameOver) return;
+    Piece moved = state.active; moved.x -= 1;
+    if(!checkCollision(moved)) state.active = moved;
+}
+
+template<int W, int H>
+void BasicGame<W, H>::moveRight()
+{
+    if(state.gameOver) return;
+    Piece moved = state.active; moved.x += 1;
+    if(!checkCollision(moved)) state.active = moved;
+}
+
+template<int W, int H>
+void BasicGame<W, H>::moveDown()
+{
+    if(state.gameOver) return;
+    Piece moved = state.active; moved.y -= 1;
+    if(!checkCollision(moved)) state.active = moved;
+    else lockPiece();
+}
+
+template<int W, int H>
+void BasicGame<W, H>::hardDrop()
+{
+    if(state.gameOver) return;
+    Piece moved = state.active;
+    while(!checkCollision(moved)){
+        moved.y -= 1;
+    }
+    moved.y += 1; // Go back to last valid position
+    state.active = moved;
+    lockPiece();
+}
+
+// Другие фиксированные размеры добавляются здесь (и extern в Game.h)
+template class BasicGame<10, 20>;
+template class BasicGame<10, 40>;
+template class BasicGame<>;
@@ -0,0 +1,249 @@
+// Game.h
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+#include "PieceGenerator.h"
+#include "Tetromino.h"
+
+struct Piece {
+    int type = 0;      // 0..6: I, O, T, L, J, S, Z (TetrominoType)
+    int rotation = 0;  // 0..3, число поворотов по часовой от появления
+    int x = 0, y = 0;  // левый нижний угол рамки фигуры
+
+    int colorIndex() const { return type + 1; }
+    const TetrominoShape& shape() const { return TETROMINOES[type][rotation]; }
+    const std::array<Cell, 4>& cells() const { return shape().cells; }
+};
+
+// Строки, снятые последней фиксацией фигуры (номера до сдвига, по возрастанию)
+struct LineClear {
+    int count = 0;
+    std::array<int, 4> rows{};
+};
+
+// Конечное положение активной фигуры (см. MoveGen.h)
+struct Placement {
+    int rotation;
+    int x, y;
+};
+
+// Размер поля, который задаётся только при создании игры (BasicGame<>)
+const int DYNAMIC_SIZE = 0;
+
+namespace game_detail {
+
+uint64_t randomSeed();
+PieceGenerator makeGenerator(uint64_t seed, GeneratorMode mode);
+
+// Над полем держим 3 всегда пустые строки: collides проверяет 4 строки рамки фигуры без ветвлений
+const int ROW_PADDING = 3;
+
+// Поле фиксированного размера: массивы внутри объекта, размеры и маски — константы.
+// Строка — uint16_t, если поле не шире 16 клеток.
+template<int W, int H>
+struct BoardStorage {
+    static_assert(W >= 4 && W <= 64 && H >= 4 && H <= 64, "board size out of range");
+    using Row = typename std::conditional<(W <= 16), uint16_t, uint64_t>::type;
+    using Rows = std::array<Row, H + ROW_PADDING>;
+    using Grid = std::array<uint8_t, W * H>;
+
+    Rows rows{};
+    Grid grid{};
+
+    BoardStorage(int, int) {}
+    static constexpr int width() { return W; }
+    static constexpr int height() { return H; }
+    static constexpr Row fullRow() { return (Row)(W == 64 ? ~0ull : (1ull << W) - 1); }
+    // Сдвиг строк над снятыми (см. Game.cpp), возвращает первую освободившуюся строку
+    int compact(int first, uint64_t full);
+    void clear() { rows.fill(0); grid.fill(0); }
+};
+
+// Поле, размер которого известен при создании: векторы; для частых размеров
+// сдвиг строк всё равно идёт через специализацию с константами (выбор в конструкторе)
+template<>
+struct BoardStorage<DYNAMIC_SIZE, DYNAMIC_SIZE> {
+    using Row = uint64_t;
+    using Rows = std::vector<Row>;
+    using Grid = std::vector<uint8_t>;
+    using CompactFn = int (*)(Row *rows, uint8_t *grid, int width, int height, int first, uint64_t full);
+
+    Rows rows;
+    Grid grid;
+
+    BoardStorage(int width, int height);   // выход за [4, 64] обрезается
+    int width() const { return w; }
+    int height() const { return h; }
+    Row fullRow() const { return full; }
+    int compact(int first, uint64_t fullMask) { return compactFn(rows.data(), grid.data(), w, h, first, fullMask); }
+    void clear() { std::fill(rows.begin(), rows.end(), 0); std::fill(grid.begin(), grid.end(), 0); }
+
+private:
+    int w, h;
+    Row full;
+    CompactFn compactFn;
+};
+
+} // namespace game_detail
+
+// Всё изменяемое состояние партии: поле, активная фигура, генератор вместе с RNG, счёт.
+// Для поля фиксированного размера тривиально копируемо и занимает несколько кэш-линий
+// (GameState<10, 20> — около 370 байт), поэтому snapshot()/restore() — одно копирование.
+// GameState<> хранит поле в векторах; копирование в существующий объект не выделяет память,
+// если размер поля не вырос.
+template<int W = DYNAMIC_SIZE, int H = DYNAMIC_SIZE>
+struct GameState {
+    game_detail::BoardStorage<W, H> board;
+    Piece active;
+    PieceGenerator generator;
+    float fallTimer = 0.0f;
+    bool gameOver = false;
+    int score = 0;
+    int totalLines = 0;
+    int piecesPlaced = 0;
+    LineClear lastClear;
+
+    GameState() : board(W ? W : 10, H ? H : 20) {}
+    GameState(int width, int height, const PieceGenerator &generator) : board(width, height), generator(generator) {}
+};
+
+static_assert(std::is_trivially_copyable<GameState<10, 20>>::value, "fixed-size GameState must be trivially copyable");
+
+// Правила игры. BasicGame<W, H> — поле W x H, известное при компиляции: строки, маски
+// и границы циклов становятся константами, поле лежит внутри объекта и не выделяет память.
+// BasicGame<> (DynamicGame) — размер задаётся при создании, поле в векторах.
+// Реализация в Game.cpp, инстанцированы StandardGame (= Game, 10x20), BasicGame<10, 40> и DynamicGame.
+template<int W = DYNAMIC_SIZE, int H = DYNAMIC_SIZE>
+class BasicGame {
+    static_assert((W == DYNAMIC_SIZE) == (H == DYNAMIC_SIZE), "width and height must both be fixed or both dynamic");
+    struct InitTag {};
+
+public:
+    using State = GameState<W, H>;
+    using Row = typename game_detail::BoardStorage<W, H>::Row;
+    using Rows = typename game_detail::BoardStorage<W, H>::Rows;
+    using Grid = typename game_detail::BoardStorage<W, H>::Grid;
+
+    static constexpr bool FIXED_SIZE = W != DYNAMIC_SIZE;
+    static constexpr int DEFAULT_WIDTH = FIXED_SIZE ? W : 10;
+    static constexpr int DEFAULT_HEIGHT = FIXED_SIZE ? H : 20;
+    // Высота ограничена ядрами BoardKernels (маска строк 64 бита)
+    static constexpr int MIN_SIZE = 4;
+    static constexpr int MAX_WIDTH = 64;
+    static constexpr int MAX_HEIGHT = 64;
+
+    BasicGame() : BasicGame(game_detail::randomSeed()) {}   // seed из std::random_device, 7-bag
+    // mode — Bag7 или Random; Sequence только через PieceGenerator::sequence (иначе abort)
+    explicit BasicGame(uint64_t seed, GeneratorMode mode = GeneratorMode::Bag7)
+        : BasicGame(game_detail::makeGenerator(seed, mode)) {}
+    explicit BasicGame(const PieceGenerator &generator)
+        : BasicGame(DEFAULT_WIDTH, DEFAULT_HEIGHT, generator, InitTag{}) {}
+
+    // Только для BasicGame<>: размер поля задаётся при создании
+    template<int W2 = W, typename std::enable_if<W2 == DYNAMIC_SIZE, int>::type = 0>
+    BasicGame(int width, int height) : BasicGame(width, height, game_detail::randomSeed()) {}
+    template<int W2 = W, typename std::enable_if<W2 == DYNAMIC_SIZE, int>::type = 0>
+    BasicGame(int width, int height, uint64_t seed, GeneratorMode mode = GeneratorMode::Bag7)
+        : BasicGame(width, height, game_detail::makeGenerator(seed, mode), InitTag{}) {}
+    template<int W2 = W, typename std::enable_if<W2 == DYNAMIC_SIZE, int>::type = 0>
+    BasicGame(int width, int height, const PieceGenerator &generator)
+        : BasicGame(width, height, generator, InitTag{}) {}
+
+    void update(float dt);
+    void moveLeft();
+    void moveRight();
+    void moveDown();
+    void hardDrop();
+    void rotate();      // по часовой
+    void rotateCCW();
+    void rotate180();
+    // Ставит активную фигуру в placement и фиксирует её; false, если положение
+    // занято или фигура в нём висит в воздухе
+    bool applyPlacement(const Placement& placement);
+
+    // Фигура type (0..6) в точке появления, повернутая rotation раз
+    Piece makePiece(int type, int rotation) const;
+    // Следующая фигура из генератора вместо активной (то же, что после фиксации);
+    // Game Over, если ей некуда встать
+    void spawnRandom();
+
+    bool checkCollision(const Piece& p) const { return collides(p.shape(), p.x, p.y); }
+    // Фигура shape с рамкой в (x, y) пересекает стенки, пол или занятые клетки.
+    // Рамка выше поля ничего не задевает; иначе её 4 строки лежат в rows (с запасом сверху).
+    bool collides(const TetrominoShape& shape, int x, int y) const
+    {
+        int left = x + shape.minX;
+        int bottom = y + shape.minY;
+        if(left < 0 || x + shape.maxX >= state.board.width() || bottom < 0) return true;
+        if(bottom >= state.board.height()) return false;
+        const Row *r = &state.board.rows[bottom];
+        if constexpr(sizeof(Row) == 2) {
+            // Строки по 16 бит: 4 строки рамки — одно 64-битное чтение (little-endian, r[0] в младших битах)
+            uint64_t window;
+            std::memcpy(&window, r, sizeof(window));
+            return (window & (shape.rowMask16 << left)) != 0;
+        }
+        return ((r[0] & ((Row)shape.rowMask[0] << left)) | (r[1] & ((Row)shape.rowMask[1] << left)) |
+                (r[2] & ((Row)shape.rowMask[2] << left)) | (r[3] & ((Row)shape.rowMask[3] << left))) != 0;
+    }
+
+    int getWidth() const { return state.board.width(); }
+    int getHeight() const { return state.board.height(); }
+    Row getFullRow() const { return state.board.fullRow(); }
+    // Цвет клетки (x, y) — grid[y * width + x], 0 = пусто
+    const Grid& getGrid() const { return state.board.grid; }
+    // Маска строки y — rows[y]; строки выше height всегда пустые
+    const Rows& getRows() const { return state.board.rows; }
+    Piece getActive() const { return state.active; }
+    bool isGameOver() const { return state.gameOver; }
+    int getScore() const { return state.score; }
+    int getLines() const { return state.totalLines; }
+    int getPieces() const { return state.piecesPlaced; }
+    // Для анимаций: какие строки сняла последняя фиксация (count = 0 — ни одной)
+    const LineClear& getLastClear() const { return state.lastClear; }
+
+    // Новая партия на том же поле без выделения памяти (рестарт в GUI)
+    void reset() { reset(game_detail::randomSeed()); }
+    void reset(uint64_t seed, GeneratorMode mode = GeneratorMode::Bag7) { reset(game_detail::makeGenerator(seed, mode)); }
+    void reset(const PieceGenerator &generator);
+
+    // Снимок и откат партии (поиск в ботах, undo). restore помечает всё поле изменённым.
+    State snapshot() const { return state; }
+    void snapshot(State &out) const { out = state; }   // переиспользует буферы out
+    void restore(const State &saved);
+
+    // Журнал изменений поля: строки [first, last], изменённые с последнего
+    // clearDirtyRows() (lockPiece ставит клетки, clearLines сдвигает строки)
+    bool getDirtyRows(int &first, int &last) const;
+    void clearDirtyRows() { dirtyFirst = state.board.height(); dirtyLast = -1; }
+
+private:
+    State state;
+    float fallInterval;
+    int dirtyFirst = 0;          // новое поле целиком "грязное"
+    int dirtyLast;
+
+    BasicGame(int width, int height, const PieceGenerator &generator, InitTag);
+
+    void markDirty(int first, int last);
+
+    void rotateBy(int turns);
+    void lockPiece();
+    void clearLines();
+};
+
+using StandardGame = BasicGame<10, 20>;
+using DynamicGame = BasicGame<>;
+// Обычная игра 10x20: без выделений памяти после создания, копируется как POD
+using Game = StandardGame;
+
+extern template class BasicGame<10, 20>;
+extern template class BasicGame<10, 40>;
+extern template class BasicGame<>;
+
+static_assert(std::is_trivially_copyable<Game>::value, "Game must stay trivially copyable");
+static_assert(sizeof(Game) <= 6 * 64, "Game should fit in a few cache lines");
@@ -0,0 +1,159 @@
+//MoveGen.cpp
+#include "MoveGen.h"
+#include "BoardKernels.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace {
+
+// Координаты состояний со сдвигом, чтобы отрицательные x/y влезли в индексы
+const int PAD = 4;
+
+struct State {
+    int8_t rot, x, y;
+};
+
+// Ключ набора клеток для отсева одинаковых положений (O, S, Z, I в разных поворотах):
+// индексы четырёх клеток по 16 бит, в порядке обхода масок строк снизу вверх
+uint64_t footprint(const TetrominoShape &s, int x, int y, int width)
+{
+    uint64_t key = 0;
+    int shift = 0;
+    for(int k = 0; k <= s.maxY - s.minY; ++k)
+        for(int bit = 0; bit < 4; ++bit)
+            if(s.rowMask[k] & (1u << bit)) {
+                key |= (uint64_t)((y + s.minY + k) * width + x + s.minX + bit) << shift;
+                shift += 16;
+            }
+    return key;
+}
+
+// Буферы поиска. Для поля фиксированного размера — массивы на стеке с размерами-константами,
+// для BasicGame<> — векторы потока, которые растут до самого большого встреченного поля.
+template<typename GameT, bool Fixed = GameT::FIXED_SIZE>
+struct SearchBuffers {
+    static const int XS = GameT::DEFAULT_WIDTH + 2 * PAD;
+    static const int YS = GameT::DEFAULT_HEIGHT + 2 * PAD;
+    static const int WORDS = (XS + 63) / 64;
+
+    std::array<uint64_t, 4 * YS * WORDS> visitedBits{};
+    std::array<State, 4 * XS * YS> queueStates;
+    std::array<uint64_t, 4 * XS * YS> seenKeys;
+
+    SearchBuffers(int, int) {}
+    uint64_t *visited() { return visitedBits.data(); }
+    State *queue() { return queueStates.data(); }
+    uint64_t *seen() { return seenKeys.data(); }
+};
+
+template<typename GameT>
+struct SearchBuffers<GameT, false> {
+    SearchBuffers(int xs, int ys)
+    {
+        static thread_local std::vector<uint64_t> visitedBits, seenKeys;
+        static thread_local std::vector<State> queueStates;
+        visitedBits.assign(4 * ys * ((xs + 63) / 64), 0);
+        queueStates.resize(4 * xs * ys);
+        seenKeys.resize(4 * xs * ys);
+        v = visitedBits.data();
+        q = queueStates.data();
+        k = seenKeys.data();
+    }
+    uint64_t *visited() { return v; }
+    State *queue() { return q; }
+    uint64_t *seen() { return k; }
+
+private:
+    uint64_t *v, *k;
+    State *q;
+};
+
+} // namespace
+
+template<typename GameT>
+void generatePlacements(const GameT &game, std::vector<Placement> &out)
+{
+    out.clear();
+    if(game.isGameOver()) return;
+
+    const int width = game.getWidth();
+    const int height = game.getHeight();
+    const int XS = width + 2 * PAD;
+    const int YS = height + 2 * PAD;
+    const int words = (XS + 63) / 64;   // слов visited на одну строку одного поворота
+
+    const auto &rows = game.getRows();
+    const Piece active = game.getActive();
+    const auto &shapes = TETROMINOES[active.type];
+
+    SearchBuffers<GameT> buffers(XS, YS);
+    uint64_t *visited = buffers.visited();
+    State *queue = buffers.queue();
+    uint64_t *seen = buffers.seen();   // footprints найденных положений
+    int head = 0, tail = 0, seenCount = 0;
+
+    auto push = [&](int rot, int x, int y) {
+        if(y + PAD < 0 || y + PAD >= YS) return;
+        uint64_t &word = visited[(rot * YS + y + PAD) * words + (x + PAD) / 64];
+        uint64_t bit = 1ull << ((x + PAD) % 64);
+        if(word & bit) return;
+        word |= bit;
+        queue[tail++] = {(int8_t)rot, (int8_t)x, (int8_t)y};
+    };
+
+    // Верх стакана: над самой высокой непустой строкой (пустые строки — одним проходом ядра)
+    uint64_t occupied = ~findEmptyRows(rows.data(), height) & (height >= 64 ? ~0ull : (1ull << height) - 1);
+    int stackTop = bitLength64(occupied);
+
+    int lowestY = 4;
+    for(auto &s : shapes) lowestY = std::min(lowestY, (int)s.minY);
+
+    if(active.y + lowestY >= stackTop) {
+        // Фигура целиком над стаканом: там пусто, поэтому любой поворот и любой x
+        // достижимы. Стартуем сразу со слоя, где нижняя клетка касается верха стакана.
+        for(int rot = 0; rot < 4; ++rot) {
+            const TetrominoShape &s = shapes[rot];
+            int y = stackTop - s.minY;
+            for(int x = -s.minX; x + s.maxX < width; ++x)
+                push(rot, x, y);
+        }
+    } else {
+        push(active.rotation, active.x, active.y);
+    }
+
+    while(head < tail) {
+        State st = queue[head++];
+        const TetrominoShape &s = shapes[st.rot];
+
+        if(!game.collides(s, st.x - 1, st.y)) push(st.rot, st.x - 1, st.y);
+        if(!game.collides(s, st.x + 1, st.y)) push(st.rot, st.x + 1, st.y);
+
+        // Повороты на 90° в обе стороны и на 180° с теми же SRS-сдвигами, что и Game
+        for(int turns = 1; turns <= 3; ++turns) {
+            int to = (st.rot + turns) & 3;
+            const KickList &kicks = srsKicks(active.type, st.rot, to);
+            for(int i = 0; i < kicks.count; ++i) {
+                int x = st.x + kicks.offsets[i].x, y = st.y + kicks.offsets[i].y;
+                if(!game.collides(shapes[to], x, y)) {
+                    push(to, x, y);
+                    break;
+                }
+            }
+        }
+
+        if(!game.collides(s, st.x, st.y - 1)) {
+            push(st.rot, st.x, st.y - 1);
+        } else {
+            uint64_t key = footprint(s, st.x, st.y, width);
+            if(std::find(seen, seen + seenCount, key) == seen + seenCount) {
+                seen[seenCount++] = key;
+                out.push_back({st.rot, st.x, st.y});
+            }
+        }
+    }
+}
+
+template void generatePlacements(const StandardGame &, std::vector<Placement> &);
+template void generatePlacements(const BasicGame<10, 40> &, std::vector<Placement> &);
+template void generatePlacements(const DynamicGame &, std::vector<Placement> &);
@@ -0,0 +1,16 @@
+// MoveGen.h
+#pragma once
+#include <vector>
+#include "Game.h"
+
+// Все конечные положения, куда активная фигура может попасть из текущего
+// положения ходами влево/вправо/вниз/повороты по SRS (включая подсовывание
+// под навесы мягким падением и твисты). Для симметричных фигур одинаковые наборы клеток
+// выдаются один раз. out очищается; при повторном использовании вектора
+// выделений памяти нет. Инстанцирован для тех же размеров поля, что и BasicGame.
+template<typename GameT>
+void generatePlacements(const GameT &game, std::vector<Placement> &out);
+
+extern template void generatePlacements(const StandardGame &, std::vector<Placement> &);
+extern template void generatePlacements(const BasicGame<10, 40> &, std::vector<Placement> &);
+extern template void generatePlacements(const DynamicGame &, std::vector<Placement> &);
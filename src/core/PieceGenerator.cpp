@@ -0,0 +1,59 @@
+//PieceGenerator.cpp
+#include "PieceGenerator.h"
+#include <utility>
+
+PieceGenerator PieceGenerator::bag7(uint64_t seed)
+{
+    PieceGenerator g;
+    g.mode = GeneratorMode::Bag7;
+    g.rng.reseed(seed);
+    return g;
+}
+
+PieceGenerator PieceGenerator::random(uint64_t seed)
+{
+    PieceGenerator g;
+    g.mode = GeneratorMode::Random;
+    g.rng.reseed(seed);
+    return g;
+}
+
+bool PieceGenerator::sequence(const int *types, int count, PieceGenerator &out)
+{
+    if(count < 1 || count > MAX_SEQUENCE) return false;
+    for(int i = 0; i < count; ++i)
+        if(types[i] < 0 || types[i] > 6) return false;
+    PieceGenerator g;
+    g.mode = GeneratorMode::Sequence;
+    for(int i = 0; i < count; ++i) g.sequenceTypes[i] = (uint8_t)types[i];
+    g.sequenceLength = (uint8_t)count;
+    out = g;
+    return true;
+}
+
+int PieceGenerator::next()
+{
+    switch(mode) {
+        case GeneratorMode::Bag7:
+            if(bagPos >= 7) refillBag();
+            return bag[bagPos++];
+        case GeneratorMode::Random:
+            return (int)rng.nextBelow(7);
+        case GeneratorMode::Sequence:
+            if(sequenceLength <= 0) return 0;
+            if(sequencePos >= sequenceLength) sequencePos = 0;
+            return sequenceTypes[sequencePos++];
+    }
+    return 0;
+}
+
+void PieceGenerator::refillBag()
+{
+    // Fisher–Yates
+    for(int i = 0; i < 7; ++i) bag[i] = (uint8_t)i;
+    for(int i = 6; i > 0; --i) {
+        int j = (int)rng.nextBelow(i + 1);
+        std::swap(bag[i], bag[j]);
+    }
+    bagPos = 0;
+}
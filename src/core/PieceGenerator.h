@@ -0,0 +1,38 @@
+// PieceGenerator.h
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Random.h"
+
+enum class GeneratorMode {
+    Bag7,      // 7-bag: каждая семёрка — перестановка всех фигур
+    Random,    // независимый равномерный выбор
+    Sequence   // заданная последовательность (по кругу)
+};
+
+// Источник фигур для Game (тип 0..6: I, O, T, L, J, S, Z).
+// Всё состояние хранится по значению, так что копия Game продолжает ту же последовательность.
+class PieceGenerator {
+public:
+    static PieceGenerator bag7(uint64_t seed);
+    static PieceGenerator random(uint64_t seed);
+    // Последовательность по кругу, копируется внутрь генератора. false (out не тронут), если
+    // count вне 1..MAX_SEQUENCE или есть тип вне 0..6: обрезанный повтор разошёлся бы с записью
+    static bool sequence(const int *types, int count, PieceGenerator &out);
+
+    static const int MAX_SEQUENCE = 32;
+
+    int next();
+    GeneratorMode getMode() const { return mode; }
+
+private:
+    GeneratorMode mode = GeneratorMode::Bag7;
+    Rng rng;
+    std::array<uint8_t, 7> bag{};
+    uint8_t bagPos = 7;           // 7 = мешок пуст
+    uint8_t sequenceLength = 0;
+    uint8_t sequencePos = 0;
+    std::array<uint8_t, MAX_SEQUENCE> sequenceTypes{};
+
+    void refillBag();
+};
@@ -0,0 +1,56 @@
+// Random.h
+#pragma once
+#include <cstdint>
+
+// xoshiro128** — быстрый ГПСЧ с состоянием 16 байт. У каждой Game свой экземпляр,
+// поэтому партии в разных потоках независимы и воспроизводимы по seed.
+class Rng {
+public:
+    explicit Rng(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t seed)
+    {
+        // splitmix64 раскладывает seed на 4 слова состояния (не все нули)
+        for(int i = 0; i < 4; i += 2) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+            s[i] = (uint32_t)z;
+            s[i + 1] = (uint32_t)(z >> 32);
+        }
+    }
+
+    uint32_t next()
+    {
+        const uint32_t result = rotl(s[1] * 5, 7) * 9;
+        const uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+        return result;
+    }
+
+    // Равномерно в [0, bound) без смещения (метод Лемира с отбраковкой)
+    uint32_t nextBelow(uint32_t bound)
+    {
+        uint64_t m = (uint64_t)next() * bound;
+        uint32_t low = (uint32_t)m;
+        if(low < bound) {
+            const uint32_t threshold = (0u - bound) % bound;
+            while(low < threshold) {
+                m = (uint64_t)next() * bound;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+private:
+    uint32_t s[4];
+
+    static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+};
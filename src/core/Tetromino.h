@@ -0,0 +1,169 @@
+// Tetromino.h
+#pragma once
+#include <array>
+#include <cstdint>
+
+// Таблицы фигур на этапе компиляции: 7 фигур x 4 поворота.
+// Координаты клеток — внутри рамки фигуры (3x3, у I — 4x4, у O — 2x2),
+// ось y вверх, (0,0) — левый нижний угол рамки. Поворот идёт вокруг центра
+// рамки (как в SRS), поэтому фигура не уезжает от точки привязки.
+
+struct Cell {
+    int8_t x, y;
+};
+
+struct TetrominoShape {
+    std::array<Cell, 4> cells;
+    int8_t minX, maxX, minY, maxY;  // границы клеток внутри рамки
+    // Маска строки minY + k, бит 0 = колонка minX (неиспользуемые строки = 0)
+    std::array<uint8_t, 4> rowMask;
+    // Те же маски по 16 бит на строку: rowMask[k] в битах 16k (для полей не шире 16)
+    uint64_t rowMask16;
+};
+
+enum TetrominoType { TETROMINO_I, TETROMINO_O, TETROMINO_T, TETROMINO_L, TETROMINO_J, TETROMINO_S, TETROMINO_Z };
+
+namespace tetromino_detail {
+
+constexpr int8_t min4(int8_t a, int8_t b, int8_t c, int8_t d)
+{
+    int8_t m = a < b ? a : b;
+    m = m < c ? m : c;
+    return m < d ? m : d;
+}
+
+constexpr int8_t max4(int8_t a, int8_t b, int8_t c, int8_t d)
+{
+    int8_t m = a > b ? a : b;
+    m = m > c ? m : c;
+    return m > d ? m : d;
+}
+
+constexpr TetrominoShape makeShape(const std::array<Cell, 4> &cells)
+{
+    TetrominoShape s{cells, 0, 0, 0, 0, {0, 0, 0, 0}, 0};
+    s.minX = min4(cells[0].x, cells[1].x, cells[2].x, cells[3].x);
+    s.maxX = max4(cells[0].x, cells[1].x, cells[2].x, cells[3].x);
+    s.minY = min4(cells[0].y, cells[1].y, cells[2].y, cells[3].y);
+    s.maxY = max4(cells[0].y, cells[1].y, cells[2].y, cells[3].y);
+    for(int i = 0; i < 4; ++i)
+        s.rowMask[cells[i].y - s.minY] |= (uint8_t)(1u << (cells[i].x - s.minX));
+    for(int k = 0; k < 4; ++k)
+        s.rowMask16 |= (uint64_t)s.rowMask[k] << (16 * k);
+    return s;
+}
+
+// Поворот на 90° по часовой внутри рамки size x size
+constexpr std::array<Cell, 4> rotateCW(const std::array<Cell, 4> &cells, int size)
+{
+    std::array<Cell, 4> r{};
+    for(int i = 0; i < 4; ++i)
+        r[i] = Cell{cells[i].y, (int8_t)(size - 1 - cells[i].x)};
+    return r;
+}
+
+constexpr std::array<TetrominoShape, 4> makeRotations(const std::array<Cell, 4> &spawn, int size)
+{
+    std::array<TetrominoShape, 4> rotations{};
+    std::array<Cell, 4> cells = spawn;
+    for(int r = 0; r < 4; ++r) {
+        rotations[r] = makeShape(cells);
+        cells = rotateCW(cells, size);
+    }
+    return rotations;
+}
+
+} // namespace tetromino_detail
+
+// Размер рамки каждой фигуры
+constexpr std::array<int, 7> TETROMINO_BOX = {4, 2, 3, 3, 3, 3, 3};
+
+// [тип][поворот]; поворот 0 — положение появления (плоской стороной вниз)
+constexpr std::array<std::array<TetrominoShape, 4>, 7> TETROMINOES = {{
+    tetromino_detail::makeRotations({{{0, 2}, {1, 2}, {2, 2}, {3, 2}}}, 4), // I
+    tetromino_detail::makeRotations({{{0, 0}, {1, 0}, {0, 1}, {1, 1}}}, 2), // O
+    tetromino_detail::makeRotations({{{1, 2}, {0, 1}, {1, 1}, {2, 1}}}, 3), // T
+    tetromino_detail::makeRotations({{{2, 2}, {0, 1}, {1, 1}, {2, 1}}}, 3), // L
+    tetromino_detail::makeRotations({{{0, 2}, {0, 1}, {1, 1}, {2, 1}}}, 3), // J
+    tetromino_detail::makeRotations({{{1, 2}, {2, 2}, {0, 1}, {1, 1}}}, 3), // S
+    tetromino_detail::makeRotations({{{0, 2}, {1, 2}, {1, 1}, {2, 1}}}, 3), // Z
+}};
+
+static_assert(TETROMINOES[TETROMINO_I][1].minX == 2 && TETROMINOES[TETROMINO_I][1].maxY == 3,
+              "I rotates around the centre of its 4x4 box");
+static_assert(TETROMINOES[TETROMINO_T][0].rowMask[0] == 0x7 && TETROMINOES[TETROMINO_T][0].rowMask[1] == 0x2,
+              "T spawns flat side down");
+
+// ---------------------------------------------------------------- SRS wall kicks
+//
+// Список сдвигов (x, y вверх) для поворота из состояния from в to; пробуются по
+// порядку, первый без столкновения выигрывает. Таблицы SRS для J/L/S/T/Z и
+// отдельная для I, у O сдвигов нет. Для 180° — таблица SRS+ (общая для всех).
+
+struct KickList {
+    uint8_t count;
+    std::array<Cell, 6> offsets;
+};
+
+namespace tetromino_detail {
+
+using KickTable = std::array<std::array<KickList, 4>, 4>;   // [from][to]
+
+// cw[from] — сдвиги для поворота from -> from + 1
+constexpr KickTable makeKickTable(const std::array<std::array<Cell, 5>, 4> &cw,
+                                  const std::array<std::array<Cell, 6>, 4> &half)
+{
+    KickTable t{};
+    for(int from = 0; from < 4; ++from) {
+        t[from][from] = KickList{1, {{{0, 0}}}};
+
+        int to = (from + 1) & 3;
+        t[from][to].count = 5;
+        for(int i = 0; i < 5; ++i) t[from][to].offsets[i] = cw[from][i];
+
+        // Обратный поворот to -> from — те же сдвиги с обратным знаком
+        t[to][from].count = 5;
+        for(int i = 0; i < 5; ++i)
+            t[to][from].offsets[i] = Cell{(int8_t)-cw[from][i].x, (int8_t)-cw[from][i].y};
+
+        t[from][(from + 2) & 3] = KickList{6, half[from]};
+    }
+    return t;
+}
+
+constexpr std::array<std::array<Cell, 6>, 4> HALF_TURN_KICKS = {{
+    {{{0, 0}, {0, 1}, {1, 1}, {-1, 1}, {1, 0}, {-1, 0}}},      // 0 -> 2
+    {{{0, 0}, {1, 0}, {1, 2}, {1, 1}, {0, 2}, {0, 1}}},        // R -> L
+    {{{0, 0}, {0, -1}, {-1, -1}, {1, -1}, {-1, 0}, {1, 0}}},   // 2 -> 0
+    {{{0, 0}, {-1, 0}, {-1, 2}, {-1, 1}, {0, 2}, {0, 1}}},     // L -> R
+}};
+
+constexpr KickTable JLSTZ_KICKS = makeKickTable({{
+    {{{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}},   // 0 -> R
+    {{{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}}},       // R -> 2
+    {{{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}}},      // 2 -> L
+    {{{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}}},    // L -> 0
+}}, HALF_TURN_KICKS);
+
+constexpr KickTable I_KICKS = makeKickTable({{
+    {{{0, 0}, {-2, 0}, {1, 0}, {-2, -1}, {1, 2}}},     // 0 -> R
+    {{{0, 0}, {-1, 0}, {2, 0}, {-1, 2}, {2, -1}}},     // R -> 2
+    {{{0, 0}, {2, 0}, {-1, 0}, {2, 1}, {-1, -2}}},     // 2 -> L
+    {{{0, 0}, {1, 0}, {-2, 0}, {1, -2}, {-2, 1}}},     // L -> 0
+}}, HALF_TURN_KICKS);
+
+constexpr KickList NO_KICKS = {1, {{{0, 0}}}};
+
+} // namespace tetromino_detail
+
+constexpr const KickList &srsKicks(int type, int from, int to)
+{
+    return type == TETROMINO_I ? tetromino_detail::I_KICKS[from][to]
+         : type == TETROMINO_O ? tetromino_detail::NO_KICKS
+         : tetromino_detail::JLSTZ_KICKS[from][to];
+}
+
+static_assert(srsKicks(TETROMINO_T, 1, 0).offsets[2].x == 1 && srsKicks(TETROMINO_T, 1, 0).offsets[2].y == -1,
+              "R -> 0 mirrors 0 -> R");
+static_assert(srsKicks(TETROMINO_I, 3, 2).offsets[1].x == -2 && srsKicks(TETROMINO_I, 3, 2).offsets[4].y == 2,
+              "I L -> 2 mirrors 2 -> L");
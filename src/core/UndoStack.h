@@ -0,0 +1,47 @@
+// UndoStack.h
+#pragma once
+#include <array>
+#include "Game.h"
+
+// Последние N снимков партии для отката ходов (поиск в ботах, undo в интерфейсе).
+// Ёмкость фиксирована и память не выделяется: при переполнении вытесняется самый старый снимок.
+// Для GameState<> слоты переиспользуют свои буферы; reserve() заранее подгоняет их под поле.
+template<typename GameT, int N>
+class UndoStack {
+public:
+    static_assert(N > 0, "UndoStack capacity must be positive");
+    using State = typename GameT::State;
+
+    // Выделить буферы всех слотов под поле game (для GameState<>), чтобы push не ходил в кучу
+    void reserve(const GameT &game)
+    {
+        for(State &s : states) game.snapshot(s);
+    }
+
+    void push(const GameT &game)
+    {
+        game.snapshot(states[(first + count) % N]);
+        if(count < N) ++count;
+        else first = (first + 1) % N;
+    }
+
+    // Возвращает game к последнему снимку и снимает его со стека; false, если стек пуст
+    bool undo(GameT &game)
+    {
+        if(count == 0) return false;
+        --count;
+        game.restore(states[(first + count) % N]);
+        return true;
+    }
+
+    const State *top() const { return count ? &states[(first + count - 1) % N] : nullptr; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr int capacity() { return N; }
+    void clear() { first = count = 0; }
+
+private:
+    std::array<State, N> states;
+    int first = 0;   // самый старый снимок
+    int count = 0;
+};
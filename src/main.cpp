@@ -8,53 +8,45 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <ctime>
 #include "Renderer.h"
+#include "BoardView.h"
+#include "GLState.h"
 #include "Game.h"
-bool rPressed = false;
+#include "FixedTimestep.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include "GpuTimer.h"
+#include "ProfilerOverlay.h"
 int windowWidth = 1280;
 int windowHeight = 720;
-Game game;
-Renderer *rendererPtr = nullptr;
+DynamicGame game;             // размер поля — из командной строки
 float lastTime = 0.0f;
+FixedTimestep simClock(60.0f); // 60 тиков симуляции в секунду
+Piece prevActive;              // фигура перед последним тиком кадра, для интерполяции
+int prevPieces = 0;            // getPieces() на прошлом кадре: новая фигура — без интерполяции
 float keyTimer = 0.0f;
 const float KEY_COOLDOWN = 0.15f; // немного медленнее, чтобы не слишком чувствительно
 float downKeyTimer = 0.0f;
 const float DOWN_KEY_COOLDOWN = 0.03f;
+bool showProfiler = false;     // F3; профилировщик пишет, только пока окно открыто
+const double TRACE_SECONDS = 10.0; // сколько последних секунд trace пишется в файл
+const char *traceExitPath = nullptr; // --trace FILE: дамп при выходе
 
-glm::vec3 colors[] = {
-    {0.2f, 0.8f, 0.8f}, // I
-    {0.9f, 0.8f, 0.2f}, // O
-    {0.7f, 0.2f, 0.8f}, // T
-    {0.8f, 0.5f, 0.2f}, // L
-    {0.2f, 0.4f, 0.8f}, // J
-    {0.2f, 0.8f, 0.4f}, // S
-    {0.8f, 0.2f, 0.2f}  // Z
-};
-
-void drawWalls(Renderer &renderer, const glm::vec3 &camPos) {
-    glm::vec3 wallColor(0.4f, 0.4f, 0.5f);
-    for (int y = -1; y < Game::HEIGHT + 1; ++y) {
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), {-0.8f, (float)y, 0.0f});
-        model = glm::scale(model, {0.4f, 0.5f, 0.5f});
-        renderer.drawCube(model, wallColor, 0.3f, 0.8f, camPos);
-
-        model = glm::translate(glm::mat4(1.0f), {Game::WIDTH - 0.2f, (float)y, 0.0f});
-        model = glm::scale(model, {0.4f, 0.5f, 0.5f});
-        renderer.drawCube(model, wallColor, 0.3f, 0.8f, camPos);
+// F12: последние TRACE_SECONDS секунд кадров в trace-ГГГГММДД-ЧЧММСС.json (chrome://tracing, Perfetto)
+void dumpTrace(const char *path) {
+    char name[64];
+    if(!path) {
+        std::time_t now = std::time(nullptr);
+        std::strftime(name, sizeof(name), "trace-%Y%m%d-%H%M%S.json", std::localtime(&now));
+        path = name;
     }
-
-    for(int x=-1;x<Game::WIDTH+1;++x){
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), { (float)x, -0.8f, 0.0f});
-        model = glm::scale(model, {0.5f, 0.4f, 0.5f});
-        renderer.drawCube(model, wallColor, 0.3f, 0.8f, camPos);
-    }
-
-    for(int x=-2;x<Game::WIDTH+2;++x)
-        for(int y=-2;y<Game::HEIGHT+2;++y){
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), {(float)x,(float)y,-0.6f});
-            model = glm::scale(model,{0.5f,0.5f,0.4f});
-            renderer.drawCube(model,{0.2f,0.2f,0.25f},0.4f,0.9f,camPos);
-        }
+    if(trace::writeChromeJson(path, TRACE_SECONDS)) std::cout << "Trace written to " << path << "\n";
+    else std::cerr << "cannot write " << path << "\n";
 }
 
 void processInput(GLFWwindow *window, float dt, bool &wasGameOver) {
@@ -62,6 +54,25 @@ void processInput(GLFWwindow *window, float dt, bool &wasGameOver) {
     downKeyTimer += dt;
     static bool spacePressed = false;
     static bool rPressed = false;
+    static bool f3Pressed = false;
+
+    if(glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS){
+        if(!f3Pressed){
+            showProfiler = !showProfiler;
+            profiler::setEnabled(showProfiler);
+            f3Pressed = true;
+        }
+    } else f3Pressed = false;
+
+#ifdef TETRIS_PROFILE
+    static bool f12Pressed = false;
+    if(glfwGetKey(window, GLFW_KEY_F12) == GLFW_PRESS){
+        if(!f12Pressed){
+            dumpTrace(nullptr);
+            f12Pressed = true;
+        }
+    } else f12Pressed = false;
+#endif
 
     if(glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS){
         if(!spacePressed){
@@ -72,7 +83,9 @@ void processInput(GLFWwindow *window, float dt, bool &wasGameOver) {
 
     if(game.isGameOver() && glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS){
         if(!rPressed){
-            game = Game();
+            game.reset(); // то же поле, без выделений памяти
+            prevActive = game.getActive();
+            prevPieces = game.getPieces();
             wasGameOver = false;
             rPressed = true;
         }
@@ -82,6 +95,8 @@ void processInput(GLFWwindow *window, float dt, bool &wasGameOver) {
         if(glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS){ game.moveLeft(); keyTimer=0;}
         if(glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS){ game.moveRight(); keyTimer=0;}
         if(glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS){ game.rotate(); keyTimer=0;}
+        if(glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS){ game.rotateCCW(); keyTimer=0;}
+        if(glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS){ game.rotate180(); keyTimer=0;}
     }
 
     if(downKeyTimer >= DOWN_KEY_COOLDOWN){
@@ -89,19 +104,36 @@ void processInput(GLFWwindow *window, float dt, bool &wasGameOver) {
     }
 }
 
+// TetrisPBR [--width W] [--height H] [--trace FILE]
+bool parseArgs(int argc, char **argv, int &width, int &height) {
+    for(int i = 1; i + 1 < argc; i += 2) {
+        if(!std::strcmp(argv[i], "--width")) width = std::atoi(argv[i + 1]);
+        else if(!std::strcmp(argv[i], "--height")) height = std::atoi(argv[i + 1]);
+        else if(!std::strcmp(argv[i], "--trace")) traceExitPath = argv[i + 1];
+        else return false;
+    }
+    return argc % 2 == 1 &&
+           width >= DynamicGame::MIN_SIZE && width <= DynamicGame::MAX_WIDTH &&
+           height >= DynamicGame::MIN_SIZE && height <= DynamicGame::MAX_HEIGHT;
+}
+
 void framebufferSizeCallback(GLFWwindow *window, int width, int height){
     windowWidth=width;
     windowHeight=height;
-    glViewport(0,0,width,height);
-    if(rendererPtr){
-        Shader *sh = rendererPtr->getShader();
-        sh->use();
-        glm::mat4 projection = glm::perspective(glm::radians(45.0f),(float)width/height,0.1f,100.0f);
-        sh->setMat4("projection",projection);
-    }
+    glstate::viewport(0,0,width,height);
 }
 
-int main(){
+int main(int argc, char **argv){
+    int boardWidth = DynamicGame::DEFAULT_WIDTH, boardHeight = DynamicGame::DEFAULT_HEIGHT;
+    if(!parseArgs(argc, argv, boardWidth, boardHeight)) {
+        std::cout << "usage: TetrisPBR [--width " << DynamicGame::MIN_SIZE << ".." << DynamicGame::MAX_WIDTH
+                  << "] [--height " << DynamicGame::MIN_SIZE << ".." << DynamicGame::MAX_HEIGHT
+                  << "] [--trace FILE]\n";
+        return 1;
+    }
+    game = DynamicGame(boardWidth, boardHeight);
+    prevActive = game.getActive();
+
     if(!glfwInit()) return -1;
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR,3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR,3);
@@ -113,17 +145,11 @@ int main(){
     glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
 
     if(!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) return -1;
-    glEnable(GL_DEPTH_TEST);
+    glstate::enable(GL_DEPTH_TEST);
 
     Renderer renderer;
-    rendererPtr = &renderer;
-    glm::vec3 camPos = {4.5f, 12.0f, 20.0f};
-    Shader *sh = renderer.getShader();
-    sh->use();
-    glm::mat4 projection = glm::perspective(glm::radians(45.0f),(float)windowWidth/windowHeight,0.1f,100.0f);
-    sh->setMat4("projection",projection);
-    glm::mat4 view = glm::lookAt(camPos,{4.5f,6.0f,0.0f},{0,1,0});
-    sh->setMat4("view",view);
+    BoardCamera camera = boardCamera(boardWidth, boardHeight);
+    BoardView boardView(renderer, boardWidth, boardHeight);
 
     lastTime = (float)glfwGetTime();
 
@@ -135,80 +161,116 @@ int main(){
     ImGui_ImplGlfw_InitForOpenGL(window,true);
     ImGui_ImplOpenGL3_Init("#version 330");
 
+    GpuTimer gpuTimer;
     bool wasGameOver = false;
+#ifdef TETRIS_PROFILE
+    trace::setEnabled(true); // запись в кольцо дешёвая: trace есть всегда, дамп — F12 или --trace
+#endif
 
     while(!glfwWindowShouldClose(window)){
         float time = (float)glfwGetTime();
         float dt = time - lastTime;
         lastTime = time;
+        gpuTimer.beginFrame();
 
-        processInput(window, dt, wasGameOver);
-        game.update(dt);
+        {
+            PROFILE_SCOPE("input");
+            processInput(window, dt, wasGameOver);
+        }
+        {
+            PROFILE_SCOPE("sim");
+            int ticks = simClock.advance(dt);
+            for(int i = 0; i < ticks; ++i) {
+                if(i == ticks - 1) prevActive = game.getActive();
+                game.update(simClock.getStep());
+            }
+            // Фигура зафиксирована (гравитацией или hard drop) и появилась новая: интерполировать не от чего
+            if(game.getPieces() != prevPieces) {
+                prevActive = game.getActive();
+                prevPieces = game.getPieces();
+            }
+        }
 
-        glViewport(0,0,windowWidth,windowHeight);
+        glstate::viewport(0,0,windowWidth,windowHeight);
         glClearColor(0.05f,0.05f,0.1f,1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        drawWalls(renderer, camPos);
-
-        const auto &grid = game.getGrid();
-        for(int y=0;y<Game::HEIGHT;++y)
-            for(int x=0;x<Game::WIDTH;++x){
-                int cellValue = grid[y*Game::WIDTH+x];
-                if(cellValue!=0){
-                    glm::mat4 model = glm::translate(glm::mat4(1.0f),{(float)x,(float)y,0.0f});
-                    model = glm::scale(model,{0.45f,0.45f,0.45f});
-                    renderer.drawCube(model, colors[cellValue-1],0.1f,0.7f,camPos);
-                }
+        if(windowHeight > 0) {
+            glm::mat4 projection = glm::perspective(glm::radians(45.0f),(float)windowWidth/windowHeight,0.1f,camera.farPlane);
+            renderer.beginFrame(camera.view, projection, camera.position);
+        }
+
+        {
+            PROFILE_SCOPE("wall draw");
+            PROFILE_GPU_SCOPE(gpuTimer, "walls");
+            boardView.drawWalls();
+        }
+        {
+            PROFILE_SCOPE("board draw");
+            PROFILE_GPU_SCOPE(gpuTimer, "board");
+            boardView.update(game);
+            boardView.drawBoard();
+            boardView.drawActivePiece(game, prevActive, simClock.getAlpha());
+        }
+
+        {
+            PROFILE_SCOPE("imgui");
+            PROFILE_GPU_SCOPE(gpuTimer, "imgui");
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+
+            ImGui::SetNextWindowPos({10,10});
+            ImGui::SetNextWindowSize({200,80});
+            ImGuiWindowFlags flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
+                                     ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar |
+                                     ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoBackground;
+            if(ImGui::Begin("Score",nullptr,flags)){
+                ImGui::Text("Score: %d", game.getScore());
+                ImGui::Text("Lines: %d", game.getLines());
             }
+            ImGui::End();
+
+#ifdef TETRIS_PROFILE
+            if(showProfiler) drawProfilerOverlay(gpuTimer);
+#endif
 
-        if (game.isGameOver() && glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS) {
-            if (!rPressed) {
-                game = Game();
-                wasGameOver = false;
-                std::cout << "Game Restarted!\n";
-                rPressed = true;
+            if(game.isGameOver() && !wasGameOver) ImGui::OpenPopup("Game Over");
+            wasGameOver = game.isGameOver();
+
+            if(ImGui::BeginPopupModal("Game Over",nullptr,ImGuiWindowFlags_AlwaysAutoResize)){
+                ImGui::Text("GAME OVER!");
+                ImGui::Separator();
+                ImGui::Text("Score: %d", game.getScore());
+                ImGui::Text("Lines: %d", game.getLines());
+                ImGui::Separator();
+                ImGui::Text("Press R to restart");
+                ImGui::EndPopup();
             }
+
+            // Бэкенд ImGui меняет программу, VAO, буферы, blend и viewport, но в конце
+            // восстанавливает их — кэш glstate остаётся верным
+            glstate::disable(GL_DEPTH_TEST);
+            ImGui::Render();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            glstate::enable(GL_DEPTH_TEST);
         }
 
-        // ImGui
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-
-        ImGui::SetNextWindowPos({10,10});
-        ImGui::SetNextWindowSize({200,80});
-        ImGuiWindowFlags flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
-                                 ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar |
-                                 ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoBackground;
-        if(ImGui::Begin("Score",nullptr,flags)){
-            ImGui::Text("Score: %d", game.getScore());
-            ImGui::Text("Lines: %d", game.getLines());
+        {
+            PROFILE_SCOPE("swap");
+            glfwSwapBuffers(window);
         }
-        ImGui::End();
-
-        if(game.isGameOver() && !wasGameOver) ImGui::OpenPopup("Game Over");
-        wasGameOver = game.isGameOver();
-
-        if(ImGui::BeginPopupModal("Game Over",nullptr,ImGuiWindowFlags_AlwaysAutoResize)){
-            ImGui::Text("GAME OVER!");
-            ImGui::Separator();
-            ImGui::Text("Score: %d", game.getScore());
-            ImGui::Text("Lines: %d", game.getLines());
-            ImGui::Separator();
-            ImGui::Text("Press R to restart");
-            ImGui::EndPopup();
+        {
+            PROFILE_SCOPE("poll");
+            glfwPollEvents();
         }
-
-        glDisable(GL_DEPTH_TEST);
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        glEnable(GL_DEPTH_TEST);
-
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+        profiler::endFrame((glfwGetTime() - time) * 1000.0);
     }
 
+#ifdef TETRIS_PROFILE
+    if(traceExitPath) dumpTrace(traceExitPath);
+#endif
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
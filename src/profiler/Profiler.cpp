@@ -0,0 +1,136 @@
+//Profiler.cpp
+#include "Profiler.h"
+#include <cstring>
+#include <mutex>
+
+namespace profiler {
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+// Скользящее среднее за ~30 кадров
+const double AVG_WEIGHT = 1.0 / 30.0;
+
+struct Zone {
+    const char *name;
+    int64_t ns;     // текущий кадр
+    int calls;
+    double lastMs, avgMs;
+    int lastCalls;
+    double totalMs;
+};
+
+struct Counter {
+    const char *name;
+    int64_t value;   // текущий кадр
+    int64_t last;
+    double avg;
+    int64_t total;
+};
+
+Zone zones[MAX_ZONES];
+Counter counters[MAX_COUNTERS];
+int zoneCount = 0, counterCount = 0;
+std::mutex registryMutex;   // только регистрация: зоны заводятся из статиков в разных потоках
+
+float history[HISTORY];
+int historyOffset = 0;
+double averageFrameMs = 0.0;
+int64_t frameCount = 0;
+Clock::time_point lastFrameEnd;
+bool haveFrameEnd = false;
+
+template<typename Entry, int N>
+int registerName(Entry (&table)[N], int &count, const char *name)
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for(int i = 0; i < count; ++i)
+        if(!std::strcmp(table[i].name, name)) return i;
+    if(count == N) return -1;
+    table[count] = Entry{};
+    table[count].name = name;
+    return count++;
+}
+
+} // namespace
+
+int registerZone(const char *name) { return registerName(zones, zoneCount, name); }
+int registerCounter(const char *name) { return registerName(counters, counterCount, name); }
+
+void addZoneTime(int zone, int64_t ns)
+{
+    if(zone < 0) return;
+    zones[zone].ns += ns;
+    ++zones[zone].calls;
+}
+
+void addCount(int counter, int64_t value)
+{
+    if(counter < 0) return;
+    counters[counter].value += value;
+}
+
+void endFrame(double frameMs)
+{
+    // Событие кадра — от прошлого endFrame до этого: так все зоны кадра оказываются внутри него
+    Clock::time_point now = Clock::now();
+    if(trace::isEnabled() && haveFrameEnd) trace::record("frame", "frame", lastFrameEnd, now);
+    lastFrameEnd = now;
+    haveFrameEnd = true;
+    for(int i = 0; i < zoneCount; ++i) {
+        Zone &z = zones[i];
+        z.lastMs = z.ns * 1e-6;
+        z.avgMs += (z.lastMs - z.avgMs) * AVG_WEIGHT;
+        z.lastCalls = z.calls;
+        z.totalMs += z.lastMs;
+        z.ns = 0;
+        z.calls = 0;
+    }
+    for(int i = 0; i < counterCount; ++i) {
+        Counter &c = counters[i];
+        c.last = c.value;
+        c.avg += (c.last - c.avg) * AVG_WEIGHT;
+        c.total += c.last;
+        c.value = 0;
+    }
+    history[historyOffset] = (float)frameMs;
+    historyOffset = (historyOffset + 1) % HISTORY;
+    averageFrameMs += (frameMs - averageFrameMs) * AVG_WEIGHT;
+    ++frameCount;
+}
+
+void resetTotals()
+{
+    for(int i = 0; i < zoneCount; ++i) zones[i].totalMs = 0.0;
+    for(int i = 0; i < counterCount; ++i) counters[i].total = 0;
+    frameCount = 0;
+}
+
+int64_t getFrameCount() { return frameCount; }
+
+int getZoneCount() { return zoneCount; }
+
+ZoneStats getZone(int i)
+{
+    const Zone &z = zones[i];
+    return {z.name, z.lastMs, z.avgMs, z.lastCalls, z.totalMs};
+}
+
+int getCounterCount() { return counterCount; }
+
+CounterStats getCounter(int i)
+{
+    const Counter &c = counters[i];
+    return {c.name, c.last, c.avg, c.total};
+}
+
+const float *getFrameHistory(int &offset)
+{
+    offset = historyOffset;
+    return history;
+}
+
+double getAverageFrameMs() { return averageFrameMs; }
+
+} // namespace profiler
@@ -0,0 +1,114 @@
+// Profiler.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "TraceRecorder.h"
+
+// Профилировщик кадра: именованные зоны (суммарное время за кадр) и счётчики.
+//
+//   void Renderer::updateBatch(...) { PROFILE_SCOPE("buffer upload"); ... }
+//   PROFILE_COUNT("draw calls", 1);
+//
+// Без TETRIS_PROFILE (cmake -DTETRIS_PROFILE=OFF) макросы компилируются в ничто. Его получают
+// только tetris_render и игра; правила ставят зоны через CORE_PROFILE_SCOPE (CoreProfile.h),
+// и они есть лишь в tetris_core_profiled — горячий путь tetris_batch и tetris_bench не платит
+// за них. Зоны и счётчики пишутся, только пока профилировщик включён (setEnabled): игра
+// включает его вместе с оверлеем.
+// Запись — из главного потока. Зоны, кроме того, уходят в trace (TraceRecorder.h),
+// пока он включён, — из любых потоков.
+namespace profiler {
+
+const int MAX_ZONES = 32;
+const int MAX_COUNTERS = 16;
+const int HISTORY = 240;   // кадров в графике времени кадра
+
+using Clock = std::chrono::steady_clock;
+
+// Флаг читают и потоки, пишущие в trace: atomic, relaxed — порядок с данными не нужен
+extern std::atomic<bool> enabled;
+
+inline void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+inline bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+// Регистрация по имени (одинаковые имена -> один id); -1, если таблица заполнена
+int registerZone(const char *name);
+int registerCounter(const char *name);
+
+void addZoneTime(int zone, int64_t ns);
+void addCount(int counter, int64_t value);
+
+// Закрывает кадр: накопленное переходит в "последний кадр", время кадра — в историю
+// (и событием "frame" в trace, если он включён)
+void endFrame(double frameMs);
+// Обнуляет итоги и число кадров (например, после прогрева в бенчмарке)
+void resetTotals();
+int64_t getFrameCount();
+
+struct ZoneStats {
+    const char *name;
+    double lastMs;   // за последний кадр
+    double avgMs;    // скользящее среднее
+    int calls;       // за последний кадр
+    double totalMs;  // с последнего resetTotals
+};
+
+struct CounterStats {
+    const char *name;
+    int64_t last;
+    double avg;
+    int64_t total;
+};
+
+int getZoneCount();
+ZoneStats getZone(int i);
+int getCounterCount();
+CounterStats getCounter(int i);
+
+// Времена кадров (мс) по кругу; offset — индекс самого старого, как у ImGui::PlotLines
+const float *getFrameHistory(int &offset);
+double getAverageFrameMs();
+
+class Scope {
+public:
+    Scope(int zone, const char *name) : zone(zone), name(name), active(isEnabled() || trace::isEnabled())
+    {
+        if(active) start = Clock::now();
+    }
+    ~Scope()
+    {
+        if(!active) return;
+        Clock::time_point end = Clock::now();
+        if(isEnabled()) addZoneTime(zone, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        if(trace::isEnabled()) trace::record(name, "zone", start, end);
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+private:
+    int zone;
+    const char *name;
+    bool active;
+    Clock::time_point start;
+};
+
+} // namespace profiler
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef TETRIS_PROFILE
+#define PROFILE_SCOPE(name) \
+    static const int PROFILE_CONCAT(profileZone_, __LINE__) = profiler::registerZone(name); \
+    profiler::Scope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profileZone_, __LINE__), name)
+#define PROFILE_COUNT(name, value) \
+    do { \
+        if(profiler::isEnabled()) { \
+            static const int profileCounter = profiler::registerCounter(name); \
+            profiler::addCount(profileCounter, (int64_t)(value)); \
+        } \
+    } while(0)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_COUNT(name, value) ((void)0)
+#endif
@@ -0,0 +1,122 @@
+//TraceRecorder.cpp
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+namespace trace {
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+// Поля атомарные (relaxed — те же обычные store на x86), чтобы чтение во время
+// записи не было гонкой; целостность события проверяет seq
+struct Slot {
+    std::atomic<uint64_t> seq{0};   // номер записи + 1; 0 — пусто или пишется
+    std::atomic<const char *> name{nullptr};
+    std::atomic<const char *> category{nullptr};
+    std::atomic<int64_t> startNs{0};
+    std::atomic<int64_t> durationNs{0};
+    std::atomic<uint32_t> thread{0};
+};
+
+Slot ring[CAPACITY];
+std::atomic<uint64_t> head{0};
+std::atomic<uint32_t> threadCount{0};
+
+uint32_t threadId()
+{
+    static thread_local uint32_t id = threadCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    return id;
+}
+
+int64_t toNs(Clock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+struct Event {
+    const char *name;
+    const char *category;
+    int64_t startNs, durationNs;
+    uint32_t thread;
+};
+
+void writeString(std::FILE *f, const char *s)
+{
+    std::fputc('"', f);
+    for(; *s; ++s) {
+        if(*s == '"' || *s == '\\') std::fputc('\\', f);
+        std::fputc(*s, f);
+    }
+    std::fputc('"', f);
+}
+
+} // namespace
+
+void record(const char *name, const char *category, Clock::time_point start, Clock::time_point end)
+{
+    uint64_t index = head.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = ring[index & (CAPACITY - 1)];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.startNs.store(toNs(start), std::memory_order_relaxed);
+    slot.durationNs.store(toNs(end) - toNs(start), std::memory_order_relaxed);
+    slot.thread.store(threadId(), std::memory_order_relaxed);
+    slot.seq.store(index + 1, std::memory_order_release);
+}
+
+bool writeChromeJson(const char *path, double lastSeconds)
+{
+    // Снимок кольца: события, которые пишутся прямо сейчас или уже затёрты, пропускаются
+    uint64_t end = head.load(std::memory_order_acquire);
+    uint64_t begin = end > (uint64_t)CAPACITY ? end - CAPACITY : 0;
+    std::vector<Event> events;
+    events.reserve((size_t)(end - begin));
+    for(uint64_t i = begin; i < end; ++i) {
+        const Slot &slot = ring[i & (CAPACITY - 1)];
+        if(slot.seq.load(std::memory_order_acquire) != i + 1) continue;
+        Event e;
+        e.name = slot.name.load(std::memory_order_relaxed);
+        e.category = slot.category.load(std::memory_order_relaxed);
+        e.startNs = slot.startNs.load(std::memory_order_relaxed);
+        e.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        e.thread = slot.thread.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.seq.load(std::memory_order_relaxed) != i + 1) continue;
+        events.push_back(e);
+    }
+
+    int64_t last = 0;
+    for(const Event &e : events) last = std::max(last, e.startNs + e.durationNs);
+    int64_t from = last - (int64_t)(lastSeconds * 1e9);
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [from](const Event &e) { return e.startNs + e.durationNs < from; }),
+                 events.end());
+    std::sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return a.startNs < b.startNs; });
+
+    std::FILE *f = std::fopen(path, "w");
+    if(!f) return false;
+    // Время — в микросекундах от первого события дампа
+    int64_t origin = events.empty() ? 0 : events.front().startNs;
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for(size_t i = 0; i < events.size(); ++i) {
+        const Event &e = events[i];
+        std::fprintf(f, "{\"name\":");
+        writeString(f, e.name);
+        std::fprintf(f, ",\"cat\":");
+        writeString(f, e.category);
+        std::fprintf(f, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}%s\n",
+                     (e.startNs - origin) * 1e-3, e.durationNs * 1e-3, e.thread,
+                     i + 1 < events.size() ? "," : "");
+    }
+    std::fprintf(f, "]}\n");
+    std::fclose(f);
+    return true;
+}
+
+} // namespace trace
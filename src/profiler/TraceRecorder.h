@@ -0,0 +1,28 @@
+// TraceRecorder.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Запись событий-интервалов для chrome://tracing / Perfetto. Каждая зона PROFILE_SCOPE и
+// каждый кадр (profiler::endFrame) — событие "X" в кольцевом буфере на CAPACITY событий:
+// старые затираются, дамп берёт последние N секунд. Запись lock-free и из любых потоков:
+// слот выдаёт fetch_add, номер записи в слоте (seqlock) отсекает недописанные при дампе.
+namespace trace {
+
+const int CAPACITY = 1 << 16;   // ~50 с при 20 событиях на кадр и 60 FPS
+
+using Clock = std::chrono::steady_clock;
+
+extern std::atomic<bool> enabled;   // см. profiler::enabled
+
+inline void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+inline bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+// name должен жить до дампа (строковый литерал)
+void record(const char *name, const char *category, Clock::time_point start, Clock::time_point end);
+
+// Последние lastSeconds секунд буфера в Chrome trace JSON; false — не удалось открыть файл
+bool writeChromeJson(const char *path, double lastSeconds);
+
+} // namespace trace
@@ -0,0 +1,179 @@
+// Bench.h
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Минимальный харнесс микробенчмарков в духе Google Benchmark (его нет в vcpkg-манифесте
+// и на серверах без сети): подбор числа итераций под минимальное время, таблица в консоль
+// и JSON в формате, который понимает tools/compare.py из Google Benchmark.
+//
+//   void benchFoo(bench::State &state) { for(auto _ : state) bench::doNotOptimize(foo()); }
+namespace bench {
+
+// Не даёт компилятору выбросить вычисление value
+template<typename T>
+inline void doNotOptimize(const T &value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    const volatile char *sink = reinterpret_cast<const volatile char *>(&value);
+    (void)*sink;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+class State {
+public:
+    explicit State(int64_t iterations) : iterations(iterations) {}
+
+    // Пустой тип, как в Google Benchmark: неиспользуемая переменная цикла не даёт -Wunused
+    struct [[maybe_unused]] Value {};
+    struct Iterator {
+        int64_t left;
+        bool operator!=(const Iterator &) const { return left != 0; }
+        void operator++() { --left; }
+        Value operator*() const { return {}; }
+    };
+    // Время идёт с первого begin() до конца цикла; подготовку делать до for
+    Iterator begin()
+    {
+        start = std::chrono::steady_clock::now();
+        cpuStart = std::clock();
+        return {iterations};
+    }
+    Iterator end()
+    {
+        return {0};
+    }
+
+    int64_t getIterations() const { return iterations; }
+    // Сколько «предметов» (фигур, клеток...) обработано за весь прогон — для items_per_second
+    void setItemsProcessed(int64_t items) { itemsProcessed = items; }
+
+private:
+    friend class Runner;
+    int64_t iterations;
+    int64_t itemsProcessed = 0;
+    std::chrono::steady_clock::time_point start;
+    std::clock_t cpuStart = 0;
+};
+
+using Function = void (*)(State &state);
+
+struct Result {
+    std::string name;
+    int64_t iterations;
+    double realNs;        // на итерацию
+    double cpuNs;
+    double itemsPerSecond;  // 0 — не задано
+    // Пользовательские счётчики (вызовы GL на кадр и т.п.), в JSON — поля рядом с временем
+    std::vector<std::pair<std::string, double>> counters;
+};
+
+class Runner {
+public:
+    double minTime = 0.5;   // секунд на итоговый прогон
+
+    void add(const std::string &name, Function fn) { benchmarks.push_back({name, fn}); }
+
+    // filter — подстрока имени (пустая — все)
+    std::vector<Result> run(const std::string &filter) const
+    {
+        std::vector<Result> results;
+        std::printf("%-40s %14s %14s %16s\n", "benchmark", "time/iter", "iterations", "items/s");
+        for(const auto &b : benchmarks) {
+            if(!filter.empty() && b.name.find(filter) == std::string::npos) continue;
+            Result r = measure(b.name, b.fn);
+            std::printf("%-40s %11.1f ns %14lld", r.name.c_str(), r.realNs, (long long)r.iterations);
+            if(r.itemsPerSecond > 0) std::printf(" %16.0f", r.itemsPerSecond);
+            std::printf("\n");
+            std::fflush(stdout);
+            results.push_back(r);
+        }
+        return results;
+    }
+
+    static bool writeJson(const char *path, const std::vector<Result> &results, const char *simd)
+    {
+        std::FILE *f = std::fopen(path, "w");
+        if(!f) return false;
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        std::fprintf(f, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"simd\": \"%s\",\n", date, simd);
+#ifdef NDEBUG
+        std::fprintf(f, "    \"library_build_type\": \"release\"\n  },\n");
+#else
+        std::fprintf(f, "    \"library_build_type\": \"debug\"\n  },\n");
+#endif
+        std::fprintf(f, "  \"benchmarks\": [\n");
+        for(size_t i = 0; i < results.size(); ++i) {
+            const Result &r = results[i];
+            std::fprintf(f, "    {\n      \"name\": \"%s\",\n      \"run_name\": \"%s\",\n      \"run_type\": \"iteration\",\n"
+                            "      \"iterations\": %lld,\n      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n"
+                            "      \"time_unit\": \"ns\"",
+                         r.name.c_str(), r.name.c_str(), (long long)r.iterations, r.realNs, r.cpuNs);
+            if(r.itemsPerSecond > 0) std::fprintf(f, ",\n      \"items_per_second\": %.1f", r.itemsPerSecond);
+            for(const auto &counter : r.counters)
+                std::fprintf(f, ",\n      \"%s\": %.3f", counter.first.c_str(), counter.second);
+            std::fprintf(f, "\n    }%s\n", i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(f, "  ]\n}\n");
+        std::fclose(f);
+        return true;
+    }
+
+private:
+    struct Entry {
+        std::string name;
+        Function fn;
+    };
+    std::vector<Entry> benchmarks;
+
+    Result measure(const std::string &name, Function fn) const
+    {
+        // Итерации удваиваются, пока прогон короче 1/10 minTime, затем пересчитываются под minTime
+        int64_t n = 1;
+        double seconds = 0.0;
+        for(;;) {
+            seconds = timeRun(fn, n).realNs * n * 1e-9;
+            if(seconds >= minTime * 0.1 || n >= (int64_t)1 << 40) break;
+            n *= 2;
+        }
+        if(seconds < minTime) {
+            double scale = minTime / (seconds > 0.0 ? seconds : 1e-9);
+            n = (int64_t)(n * (scale < 100.0 ? scale : 100.0)) + 1;
+        }
+        Result r = timeRun(fn, n);
+        r.name = name;
+        return r;
+    }
+
+    static Result timeRun(Function fn, int64_t n)
+    {
+        State state(n);
+        fn(state);
+        auto stop = std::chrono::steady_clock::now();
+        std::clock_t cpuStop = std::clock();
+        double real = std::chrono::duration<double>(stop - state.start).count();
+        double cpu = (double)(cpuStop - state.cpuStart) / CLOCKS_PER_SEC;
+
+        Result r;
+        r.iterations = n;
+        r.realNs = real * 1e9 / n;
+        r.cpuNs = cpu * 1e9 / n;
+        r.itemsPerSecond = state.itemsProcessed > 0 && real > 0.0 ? state.itemsProcessed / real : 0.0;
+        return r;
+    }
+};
+
+} // namespace bench
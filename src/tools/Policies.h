@@ -0,0 +1,73 @@
+// Policies.h
+// Политики самоигры для tetris_batch и tetris_alloc_test: каждая ставит одну фигуру
+// (заканчивается фиксацией: hardDrop и т.п.), выбираются по имени.
+#pragma once
+#include <vector>
+#include "BoardKernels.h"
+#include "Game.h"
+#include "MoveGen.h"
+#include "Random.h"
+#include "UndoStack.h"
+
+template<typename GameT>
+using Policy = void (*)(GameT &game, Rng &rng);
+
+template<typename GameT>
+void playRandom(GameT &game, Rng &rng)
+{
+    int rotations = (int)rng.nextBelow(4);
+    for(int i = 0; i < rotations; ++i) game.rotate();
+    int shift = (int)rng.nextBelow(game.getWidth()) - game.getWidth() / 2;
+    for(int i = 0; i < shift; ++i) game.moveRight();
+    for(int i = 0; i > shift; --i) game.moveLeft();
+    game.hardDrop();
+}
+
+// Оценка поля: высота, дыры и неровность (веса эвристики Yiyuan Lee)
+template<typename GameT>
+double evaluateBoard(const GameT &game)
+{
+    BoardFeatures f;
+    analyzeBoard(game.getRows().data(), game.getHeight(), game.getWidth(), f);
+    return -0.51 * f.aggregateHeight - 0.36 * f.holes - 0.18 * f.bumpiness;
+}
+
+// Все достижимые положения из генератора ходов: каждое ставится в саму партию,
+// оценивается и откатывается через UndoStack. Буферы thread_local: первый ход
+// в потоке выделяет память, дальше — нет
+template<typename GameT>
+void playGreedy(GameT &game, Rng &)
+{
+    thread_local std::vector<Placement> placements;
+    generatePlacements(game, placements);
+    if(placements.empty()) { game.hardDrop(); return; }
+
+    thread_local UndoStack<GameT, 1> undo;   // для GameState<> буферы переиспользуются
+    undo.push(game);
+    const int lines = game.getLines();
+
+    double bestScore = -1e30;
+    const Placement *best = &placements[0];
+    for(const Placement &p : placements) {
+        game.applyPlacement(p);
+        double score = evaluateBoard(game) + 0.76 * (game.getLines() - lines);
+        if(game.isGameOver()) score -= 1e6;
+        if(score > bestScore) {
+            bestScore = score;
+            best = &p;
+        }
+        game.restore(*undo.top());   // снимок остаётся на стеке для следующего положения
+    }
+    undo.clear();
+    game.applyPlacement(*best);
+}
+
+inline const char *const POLICY_NAMES[] = {"random", "greedy"};
+const int POLICY_COUNT = 2;
+
+template<typename GameT>
+Policy<GameT> policyByIndex(int index)
+{
+    static const Policy<GameT> policies[POLICY_COUNT] = {playRandom<GameT>, playGreedy<GameT>};
+    return policies[index];
+}
@@ -0,0 +1,66 @@
+// WorkStealingPool.h
+#pragma once
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Random.h"
+
+// Раздаёт задачи 0..taskCount-1 по потокам: каждому достаётся свой отрезок,
+// поток берёт задачи со своего конца очереди, а опустев — крадёт с начала чужой.
+// task(workerId, taskIndex) вызывается ровно один раз на задачу; общих изменяемых
+// данных между задачами нет, результаты каждый поток копит у себя по workerId.
+template<typename Task>
+void runWorkStealing(int taskCount, int threadCount, Task &&task)
+{
+    if(threadCount < 1) threadCount = 1;
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+    std::vector<WorkerQueue> queues(threadCount);
+    for(int w = 0; w < threadCount; ++w) {
+        int begin = (int)((long long)taskCount * w / threadCount);
+        int end = (int)((long long)taskCount * (w + 1) / threadCount);
+        for(int i = begin; i < end; ++i) queues[w].tasks.push_back(i);
+    }
+
+    auto popOwn = [&](int w, int &out) {
+        std::lock_guard<std::mutex> lock(queues[w].mutex);
+        if(queues[w].tasks.empty()) return false;
+        out = queues[w].tasks.back();
+        queues[w].tasks.pop_back();
+        return true;
+    };
+    auto steal = [&](int victim, int &out) {
+        std::lock_guard<std::mutex> lock(queues[victim].mutex);
+        if(queues[victim].tasks.empty()) return false;
+        out = queues[victim].tasks.front();
+        queues[victim].tasks.pop_front();
+        return true;
+    };
+
+    auto worker = [&](int w) {
+        Rng victimRng((uint64_t)w);
+        int index;
+        for(;;) {
+            if(popOwn(w, index)) { task(w, index); continue; }
+
+            // Своя очередь пуста: обходим остальные с случайного места
+            bool stolen = false;
+            int start = (int)victimRng.nextBelow((uint32_t)threadCount);
+            for(int k = 0; k < threadCount && !stolen; ++k) {
+                int victim = (start + k) % threadCount;
+                if(victim != w) stolen = steal(victim, index);
+            }
+            if(!stolen) return; // задачи только убывают, значит всё разобрано
+            task(w, index);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(int w = 1; w < threadCount; ++w) threads.emplace_back(worker, w);
+    worker(0);
+    for(auto &t : threads) t.join();
+}
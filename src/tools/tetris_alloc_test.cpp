@@ -0,0 +1,120 @@
+// tetris_alloc_test.cpp
+// Проверка, что операции с партией не ходят в кучу: свой operator new считает выделения
+// в текущем потоке. StandardGame не выделяет ничего; DynamicGame — только при создании
+// поля (конструктор, копия в новый объект, новый State/UndoStack).
+// Код возврата 1, если выделяет что-то ещё. Запускается из ctest.
+//
+//   tetris_alloc_test
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "Game.h"
+#include "Policies.h"
+#include "Random.h"
+#include "UndoStack.h"
+
+static thread_local long long heapAllocations = 0;
+
+void *operator new(std::size_t size)
+{
+    ++heapAllocations;
+    if(void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+static bool report(const char *what, long long allocs, bool allowed)
+{
+    bool ok = allowed || allocs == 0;
+    std::printf("  %-28s %6lld%s\n", what, allocs, ok ? "" : "   FAIL");
+    return ok;
+}
+
+// Создание, копирование, reset, snapshot/restore, UndoStack и игра обеими политиками.
+// Память может выделять только создание, и только если createMayAllocate (DynamicGame).
+template<typename GameT, typename MakeGame>
+static bool checkAllocations(const char *engine, MakeGame makeGame, bool createMayAllocate)
+{
+    std::printf("%s\n", engine);
+    bool ok = true;
+    long long start = heapAllocations;
+    GameT game = makeGame(1);
+    GameT other = makeGame(2);
+    ok &= report("construct", heapAllocations - start, createMayAllocate);
+
+    start = heapAllocations;
+    GameT copy = game;
+    ok &= report("copy construct", heapAllocations - start, createMayAllocate);
+    start = heapAllocations;
+    copy = other;
+    ok &= report("copy assign", heapAllocations - start, false);
+
+    start = heapAllocations;
+    typename GameT::State saved = game.snapshot();
+    UndoStack<GameT, 4> undo;
+    undo.reserve(game);
+    ok &= report("create State / UndoStack", heapAllocations - start, createMayAllocate);
+
+    // Прогрев буферов политик (thread_local, по разу на поток) — до замеров игры
+    Rng rng(3);
+    playRandom(copy, rng);
+    playGreedy(copy, rng);
+
+    start = heapAllocations;
+    game.reset(4);
+    game.reset();
+    ok &= report("reset", heapAllocations - start, false);
+
+    start = heapAllocations;
+    for(int i = 0; i < 10; ++i) playRandom(game, rng);
+    game.snapshot(saved);
+    for(int i = 0; i < 10; ++i) playRandom(game, rng);
+    game.restore(saved);
+    ok &= report("snapshot / restore", heapAllocations - start, false);
+
+    // 6 снимков в стек на 4: два старых вытесняются, откат возвращает 4 последних
+    start = heapAllocations;
+    int pieces[6];
+    for(int i = 0; i < 6; ++i) {
+        pieces[i] = game.getPieces();
+        undo.push(game);
+        playRandom(game, rng);
+    }
+    bool undone = true;
+    for(int i = 5; i >= 2; --i) undone &= undo.undo(game) && game.getPieces() == pieces[i];
+    undone &= !undo.undo(game);
+    ok &= report("UndoStack push / undo", heapAllocations - start, false);
+    if(!undone) {
+        std::printf("  UndoStack restored the wrong states   FAIL\n");
+        ok = false;
+    }
+
+    start = heapAllocations;
+    for(int policy = 0; policy < POLICY_COUNT; ++policy) {
+        copy.reset(5);
+        for(int i = 0; i < 200 && !copy.isGameOver(); ++i) policyByIndex<GameT>(policy)(copy, rng);
+    }
+    ok &= report("play (random, greedy)", heapAllocations - start, false);
+    return ok;
+}
+
+// DynamicGame — на стандартном поле (сдвиг строк через специализацию 10x20)
+// и на нестандартном (общий путь)
+static bool checkDynamic(int width, int height)
+{
+    std::string name = "dynamic " + std::to_string(width) + "x" + std::to_string(height);
+    return checkAllocations<DynamicGame>(name.c_str(), [&](uint64_t s) { return DynamicGame(width, height, s); }, true);
+}
+
+int main()
+{
+    std::printf("heap allocations per operation\n");
+    bool ok = checkAllocations<StandardGame>("standard 10x20", [](uint64_t s) { return StandardGame(s); }, false);
+    ok &= checkDynamic(10, 20);
+    ok &= checkDynamic(7, 33);
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
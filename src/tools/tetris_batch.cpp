@@ -0,0 +1,252 @@
+// tetris_batch.cpp
+// Массовая игра без графики: N партий с заданными seed'ами на пуле потоков
+// с перехватом задач, политика выбирается по имени.
+//
+//   tetris_batch [--games N] [--threads T] [--seed S] [--policy random|greedy] [--max-pieces P]
+//                [--width W] [--height H] [--engine dynamic|standard|compare]
+//
+// standard — StandardGame (10x20, размеры на этапе компиляции), dynamic — DynamicGame с размером
+// при создании; compare прогоняет одни и те же партии на обоих и печатает ускорение.
+// Отсутствие выделений памяти при игре проверяет tetris_alloc_test.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BoardKernels.h"
+#include "Game.h"
+#include "Policies.h"
+#include "Random.h"
+#include "WorkStealingPool.h"
+
+// ---------------------------------------------------------------- statistics
+
+struct Histogram {
+    int binWidth;
+    std::vector<long long> bins;
+
+    explicit Histogram(int binWidth) : binWidth(binWidth) {}
+
+    void add(int value)
+    {
+        size_t bin = (size_t)(std::max(value, 0) / binWidth);
+        if(bin >= bins.size()) bins.resize(bin + 1, 0);
+        bins[bin]++;
+    }
+
+    void merge(const Histogram &other)
+    {
+        if(other.bins.size() > bins.size()) bins.resize(other.bins.size(), 0);
+        for(size_t i = 0; i < other.bins.size(); ++i) bins[i] += other.bins[i];
+    }
+
+    void print(const char *title) const
+    {
+        long long peak = 1;
+        for(long long c : bins) peak = std::max(peak, c);
+        std::printf("\n%s (bin %d)\n", title, binWidth);
+        for(size_t i = 0; i < bins.size(); ++i) {
+            if(bins[i] == 0) continue;
+            int bar = (int)(40 * bins[i] / peak);
+            std::printf("  [%7lld, %7lld)  %8lld  %s\n",
+                        (long long)i * binWidth, (long long)(i + 1) * binWidth, bins[i],
+                        std::string(bar, '#').c_str());
+        }
+    }
+};
+
+struct Summary {
+    long long sum = 0;
+    int min = 0, max = 0;
+    long long count = 0;
+
+    void add(int v)
+    {
+        if(count == 0 || v < min) min = v;
+        if(count == 0 || v > max) max = v;
+        sum += v;
+        count++;
+    }
+
+    void merge(const Summary &o)
+    {
+        if(o.count == 0) return;
+        if(count == 0 || o.min < min) min = o.min;
+        if(count == 0 || o.max > max) max = o.max;
+        sum += o.sum;
+        count += o.count;
+    }
+
+    void print(const char *name) const
+    {
+        std::printf("%-8s mean %10.1f   min %8d   max %8d\n", name, count ? (double)sum / count : 0.0, min, max);
+    }
+};
+
+// Каждый поток пишет только в свои BatchStats, слияние — после join
+struct BatchStats {
+    Histogram scoreHist{1000}, linesHist{10}, lengthHist{50};
+    Summary score, lines, length;
+
+    template<typename GameT>
+    void add(const GameT &game)
+    {
+        scoreHist.add(game.getScore());
+        linesHist.add(game.getLines());
+        lengthHist.add(game.getPieces());
+        score.add(game.getScore());
+        lines.add(game.getLines());
+        length.add(game.getPieces());
+    }
+
+    void merge(const BatchStats &o)
+    {
+        scoreHist.merge(o.scoreHist);
+        linesHist.merge(o.linesHist);
+        lengthHist.merge(o.lengthHist);
+        score.merge(o.score);
+        lines.merge(o.lines);
+        length.merge(o.length);
+    }
+};
+
+// seed партии зависит только от базового seed и номера партии, а не от потока
+static uint64_t gameSeed(uint64_t baseSeed, int index)
+{
+    uint64_t z = baseSeed + 0x9E3779B97F4A7C15ull * (uint64_t)(index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// ---------------------------------------------------------------- runner
+
+struct BatchOptions {
+    int games = 1000;
+    int threads = 1;
+    uint64_t seed = 1;
+    int maxPieces = 10000;
+    int width = DynamicGame::DEFAULT_WIDTH;
+    int height = DynamicGame::DEFAULT_HEIGHT;
+    int policy = 1;   // индекс в POLICY_NAMES
+};
+
+struct BatchResult {
+    BatchStats total;
+    double seconds = 0.0;
+};
+
+// makeGame(seed) создаёт партию нужного типа
+template<typename GameT, typename MakeGame>
+static BatchResult runBatch(const BatchOptions &opt, MakeGame makeGame)
+{
+    const Policy<GameT> play = policyByIndex<GameT>(opt.policy);
+    std::vector<BatchStats> perWorker(opt.threads);
+    auto start = std::chrono::steady_clock::now();
+
+    runWorkStealing(opt.games, opt.threads, [&](int worker, int index) {
+        uint64_t s = gameSeed(opt.seed, index);
+        GameT game = makeGame(s);
+        Rng policyRng(s ^ 0xD1B54A32D192ED03ull);
+        while(!game.isGameOver() && game.getPieces() < opt.maxPieces)
+            play(game, policyRng);
+        perWorker[worker].add(game);
+    });
+
+    BatchResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for(auto &s : perWorker) result.total.merge(s);
+    return result;
+}
+
+static BatchResult runDynamic(const BatchOptions &opt)
+{
+    return runBatch<DynamicGame>(opt, [&](uint64_t s) { return DynamicGame(opt.width, opt.height, s); });
+}
+
+static BatchResult runStandard(const BatchOptions &opt)
+{
+    return runBatch<StandardGame>(opt, [](uint64_t s) { return StandardGame(s); });
+}
+
+static void printTiming(const char *engine, int games, const BatchResult &r)
+{
+    std::printf("%-8s time %.3f s   %.1f games/s   %.0f pieces/s\n",
+                engine, r.seconds, games / r.seconds, r.total.length.sum / r.seconds);
+}
+
+static void usage()
+{
+    std::fprintf(stderr,
+        "usage: tetris_batch [--games N] [--threads T] [--seed S] [--policy random|greedy] [--max-pieces P]\n"
+        "                    [--width W] [--height H]   (board %d..%d x %d..%d, default %dx%d)\n"
+        "                    [--engine dynamic|standard|compare]   (standard/compare: 10x20 only)\n",
+        DynamicGame::MIN_SIZE, DynamicGame::MAX_WIDTH, DynamicGame::MIN_SIZE, DynamicGame::MAX_HEIGHT, DynamicGame::DEFAULT_WIDTH, DynamicGame::DEFAULT_HEIGHT);
+}
+
+int main(int argc, char **argv)
+{
+    BatchOptions opt;
+    opt.threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    const char *engine = nullptr;   // по умолчанию standard для 10x20, иначе dynamic
+
+    for(int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if(!value) { usage(); return 1; }
+        if(!std::strcmp(arg, "--games")) opt.games = std::atoi(value);
+        else if(!std::strcmp(arg, "--threads")) opt.threads = std::atoi(value);
+        else if(!std::strcmp(arg, "--seed")) opt.seed = std::strtoull(value, nullptr, 10);
+        else if(!std::strcmp(arg, "--max-pieces")) opt.maxPieces = std::atoi(value);
+        else if(!std::strcmp(arg, "--width")) opt.width = std::atoi(value);
+        else if(!std::strcmp(arg, "--height")) opt.height = std::atoi(value);
+        else if(!std::strcmp(arg, "--engine")) engine = value;
+        else if(!std::strcmp(arg, "--policy")) {
+            opt.policy = -1;
+            for(int p = 0; p < POLICY_COUNT; ++p)
+                if(!std::strcmp(POLICY_NAMES[p], value)) opt.policy = p;
+            if(opt.policy < 0) { std::fprintf(stderr, "unknown policy: %s\n", value); return 1; }
+        } else { usage(); return 1; }
+        ++i;
+    }
+    bool standardSize = opt.width == StandardGame::DEFAULT_WIDTH && opt.height == StandardGame::DEFAULT_HEIGHT;
+    if(!engine) engine = standardSize ? "standard" : "dynamic";
+    bool knownEngine = !std::strcmp(engine, "dynamic") || !std::strcmp(engine, "standard") || !std::strcmp(engine, "compare");
+    if(opt.games < 1 || opt.threads < 1 || !knownEngine || (std::strcmp(engine, "dynamic") && !standardSize) ||
+       opt.width < DynamicGame::MIN_SIZE || opt.width > DynamicGame::MAX_WIDTH || opt.height < DynamicGame::MIN_SIZE || opt.height > DynamicGame::MAX_HEIGHT) {
+        usage();
+        return 1;
+    }
+
+    std::printf("games %d   threads %d   policy %s   seed %llu   board %dx%d   engine %s   simd %s\n",
+                opt.games, opt.threads, POLICY_NAMES[opt.policy], (unsigned long long)opt.seed,
+                opt.width, opt.height, engine, simdLevelName(getSimdLevel()));
+
+    BatchResult result;
+    if(!std::strcmp(engine, "compare")) {
+        BatchResult dynamic = runDynamic(opt);
+        result = runStandard(opt);
+        printTiming("dynamic", opt.games, dynamic);
+        printTiming("standard", opt.games, result);
+        // Движки обязаны играть одинаково: иначе сравнение скорости бессмысленно
+        bool same = dynamic.total.score.sum == result.total.score.sum &&
+                    dynamic.total.length.sum == result.total.length.sum;
+        std::printf("speedup  %.2fx   results %s\n", dynamic.seconds / result.seconds, same ? "identical" : "DIFFER");
+        if(!same) return 1;
+    } else {
+        result = !std::strcmp(engine, "standard") ? runStandard(opt) : runDynamic(opt);
+        printTiming(engine, opt.games, result);
+    }
+
+    const BatchStats &total = result.total;
+    total.score.print("score");
+    total.lines.print("lines");
+    total.length.print("pieces");
+    total.scoreHist.print("score");
+    total.linesHist.print("lines");
+    total.lengthHist.print("pieces (game length)");
+    return 0;
+}
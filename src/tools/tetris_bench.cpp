@@ -0,0 +1,280 @@
+// tetris_bench.cpp
+// Микробенчмарки движка: столкновения, повороты, hardDrop (в том числе со снятием 0..4 линий),
+// появление фигуры, целые случайные партии и ядра BoardKernels на каждом доступном уровне SIMD.
+// Каждый тест — для StandardGame и DynamicGame (10x20).
+//
+//   tetris_bench [--filter SUBSTR] [--min-time SECONDS] [--json FILE]
+//
+// JSON совместим с Google Benchmark: сравнение двух коммитов —
+//   compare.py benchmarks old.json new.json
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "BoardKernels.h"
+#include "Game.h"
+#include "MoveGen.h"
+#include "Random.h"
+
+// ---------------------------------------------------------------- positions
+
+// Середина партии: 30 фигур, каждая — в самое низкое положение из генератора ходов
+template<typename GameT>
+static GameT midGame(GameT game)
+{
+    std::vector<Placement> placements;
+    for(int i = 0; i < 30 && !game.isGameOver(); ++i) {
+        generatePlacements(game, placements);
+        const Placement *lowest = &placements[0];
+        for(const Placement &p : placements)
+            if(p.y < lowest->y) lowest = &p;
+        game.applyPlacement(*lowest);
+    }
+    return game;
+}
+
+template<typename GameT>
+static GameT makeGame(uint64_t seed)
+{
+    return GameT(seed);
+}
+
+template<>
+DynamicGame makeGame<DynamicGame>(uint64_t seed)
+{
+    return DynamicGame(DynamicGame::DEFAULT_WIDTH, DynamicGame::DEFAULT_HEIGHT, seed);
+}
+
+// Колодец в колонке 0: нижние lines строк заполнены кроме неё, активная — вертикальная I
+// над колодцем. hardDrop из этого состояния снимает ровно lines линий.
+template<typename GameT>
+static typename GameT::State wellState(const GameT &game, int lines)
+{
+    typename GameT::State state = game.snapshot();
+    auto &board = state.board;
+    for(int y = 0; y < board.height(); ++y) board.rows[y] = 0;
+    for(auto &cell : board.grid) cell = 0;
+    for(int y = 0; y < lines; ++y) {
+        board.rows[y] = (typename GameT::Row)(board.fullRow() & ~1ull);
+        for(int x = 1; x < board.width(); ++x) board.grid[y * board.width() + x] = 1;
+    }
+    state.active = game.makePiece(TETROMINO_I, 1);
+    state.active.x = -TETROMINOES[TETROMINO_I][1].minX;
+    state.lastClear = LineClear{};
+    return state;
+}
+
+// ---------------------------------------------------------------- benchmarks
+
+template<typename GameT>
+static void benchCheckCollision(bench::State &state)
+{
+    GameT game = midGame(makeGame<GameT>(1));
+    // Заранее набранные случайные положения, часть за стенками и под полом
+    struct Query { const TetrominoShape *shape; int x, y; };
+    std::vector<Query> queries(1024);
+    Rng rng(7);
+    for(auto &q : queries) {
+        q.shape = &TETROMINOES[rng.nextBelow(7)][rng.nextBelow(4)];
+        q.x = (int)rng.nextBelow(game.getWidth() + 2) - 2;
+        q.y = (int)rng.nextBelow(game.getHeight() + 1) - 1;
+    }
+    size_t i = 0;
+    for(auto _ : state) {
+        const Query &q = queries[i++ & 1023];
+        bench::doNotOptimize(game.collides(*q.shape, q.x, q.y));
+    }
+}
+
+template<typename GameT>
+static void benchRotate(bench::State &state)
+{
+    GameT game = makeGame<GameT>(1);
+    for(int i = 0; i < 5; ++i) game.moveDown();   // подальше от верха: поворот без сдвигов
+    for(auto _ : state) {
+        game.rotate();
+        bench::doNotOptimize(game.getActive());
+    }
+}
+
+// Откат снимка — база для тестов ниже, которые откатываются каждую итерацию
+template<typename GameT>
+static void benchRestore(bench::State &state)
+{
+    GameT game = midGame(makeGame<GameT>(1));
+    const typename GameT::State saved = game.snapshot();
+    for(auto _ : state) {
+        game.restore(saved);
+        bench::doNotOptimize(game.getActive());
+    }
+}
+
+// hardDrop + фиксация + появление следующей, с откатом снимка
+template<typename GameT>
+static void benchHardDrop(bench::State &state)
+{
+    GameT game = midGame(makeGame<GameT>(1));
+    const typename GameT::State saved = game.snapshot();
+    for(auto _ : state) {
+        game.restore(saved);
+        game.hardDrop();
+        bench::doNotOptimize(game.getActive());
+    }
+}
+
+// restore + hardDrop, который снимает LINES линий (фиксация, снятие, появление следующей).
+// Снятие линий — приватная часть фиксации; его цена — разница с hardDropClear/0 и restore
+template<typename GameT, int LINES>
+static void benchHardDropClear(bench::State &state)
+{
+    GameT game = makeGame<GameT>(1);
+    const typename GameT::State well = wellState(game, LINES);
+    game.restore(well);
+    game.hardDrop();
+    if(game.getLastClear().count != LINES) {
+        std::fprintf(stderr, "hardDropClear/%d: position cleared %d lines\n", LINES, game.getLastClear().count);
+        std::exit(1);
+    }
+    for(auto _ : state) {
+        game.restore(well);
+        game.hardDrop();
+        bench::doNotOptimize(game.getLastClear());
+    }
+}
+
+// spawnRandom движка: следующий тип из 7-bag, makePiece, проверка Game Over
+template<typename GameT>
+static void benchSpawn(bench::State &state)
+{
+    GameT game = midGame(makeGame<GameT>(1));
+    for(auto _ : state) {
+        game.spawnRandom();
+        bench::doNotOptimize(game.getActive());
+    }
+}
+
+// ---------------------------------------------------------------- board kernels
+
+// Ядра BoardKernels на поле середины партии при уровне SIMD LEVEL (setSimdLevel);
+// после прогона возвращается лучший доступный уровень
+template<typename GameT, SimdLevel LEVEL>
+static void benchFindFullRows(bench::State &state)
+{
+    GameT game = midGame(makeGame<GameT>(1));
+    setSimdLevel(LEVEL);
+    for(auto _ : state)
+        bench::doNotOptimize(findFullRows(game.getRows().data(), game.getHeight(), game.getFullRow()));
+    setSimdLevel(detectSimdLevel());
+}
+
+template<typename GameT, SimdLevel LEVEL>
+static void benchFindEmptyRows(bench::State &state)
+{
+    GameT game = midGame(makeGame<GameT>(1));
+    setSimdLevel(LEVEL);
+    for(auto _ : state)
+        bench::doNotOptimize(findEmptyRows(game.getRows().data(), game.getHeight()));
+    setSimdLevel(detectSimdLevel());
+}
+
+template<typename GameT, SimdLevel LEVEL>
+static void benchAnalyzeBoard(bench::State &state)
+{
+    GameT game = midGame(makeGame<GameT>(1));
+    BoardFeatures features;
+    setSimdLevel(LEVEL);
+    for(auto _ : state) {
+        analyzeBoard(game.getRows().data(), game.getHeight(), game.getWidth(), features);
+        bench::doNotOptimize(features);
+    }
+    setSimdLevel(detectSimdLevel());
+}
+
+// Целая партия со случайной политикой (как tetris_batch --policy random); items = фигуры
+template<typename GameT>
+static void benchRandomGame(bench::State &state)
+{
+    uint64_t seed = 1;
+    int64_t pieces = 0;
+    for(auto _ : state) {
+        GameT game = makeGame<GameT>(seed);
+        Rng rng(seed++);
+        while(!game.isGameOver() && game.getPieces() < 10000) {
+            int rotations = (int)rng.nextBelow(4);
+            for(int i = 0; i < rotations; ++i) game.rotate();
+            int shift = (int)rng.nextBelow(game.getWidth()) - game.getWidth() / 2;
+            for(int i = 0; i < shift; ++i) game.moveRight();
+            for(int i = 0; i > shift; --i) game.moveLeft();
+            game.hardDrop();
+        }
+        pieces += game.getPieces();
+    }
+    state.setItemsProcessed(pieces);
+}
+
+// kernels/<engine>/<ядро>/<уровень> для всех уровней, которые есть у процессора
+template<typename GameT, SimdLevel LEVEL>
+static void addKernels(bench::Runner &runner, const std::string &engine)
+{
+    if((int)LEVEL > (int)detectSimdLevel()) return;
+    std::string level = simdLevelName(LEVEL);
+    runner.add("kernels/" + engine + "/findFullRows/" + level, benchFindFullRows<GameT, LEVEL>);
+    runner.add("kernels/" + engine + "/findEmptyRows/" + level, benchFindEmptyRows<GameT, LEVEL>);
+    runner.add("kernels/" + engine + "/analyzeBoard/" + level, benchAnalyzeBoard<GameT, LEVEL>);
+}
+
+template<typename GameT>
+static void addEngine(bench::Runner &runner, const std::string &engine)
+{
+    runner.add(engine + "/checkCollision", benchCheckCollision<GameT>);
+    runner.add(engine + "/rotate", benchRotate<GameT>);
+    runner.add(engine + "/restore", benchRestore<GameT>);
+    runner.add(engine + "/hardDrop", benchHardDrop<GameT>);
+    runner.add(engine + "/hardDropClear/0", benchHardDropClear<GameT, 0>);
+    runner.add(engine + "/hardDropClear/1", benchHardDropClear<GameT, 1>);
+    runner.add(engine + "/hardDropClear/2", benchHardDropClear<GameT, 2>);
+    runner.add(engine + "/hardDropClear/3", benchHardDropClear<GameT, 3>);
+    runner.add(engine + "/hardDropClear/4", benchHardDropClear<GameT, 4>);
+    runner.add(engine + "/spawn", benchSpawn<GameT>);
+    runner.add(engine + "/randomGame", benchRandomGame<GameT>);
+    addKernels<GameT, SimdLevel::Scalar>(runner, engine);
+    addKernels<GameT, SimdLevel::SSE2>(runner, engine);
+    addKernels<GameT, SimdLevel::AVX2>(runner, engine);
+}
+
+static void usage()
+{
+    std::fprintf(stderr, "usage: tetris_bench [--filter SUBSTR] [--min-time SECONDS] [--json FILE]\n");
+}
+
+int main(int argc, char **argv)
+{
+    bench::Runner runner;
+    std::string filter;
+    const char *jsonPath = nullptr;
+
+    for(int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if(!value) { usage(); return 1; }
+        if(!std::strcmp(arg, "--filter")) filter = value;
+        else if(!std::strcmp(arg, "--min-time")) runner.minTime = std::atof(value);
+        else if(!std::strcmp(arg, "--json")) jsonPath = value;
+        else { usage(); return 1; }
+        ++i;
+    }
+    if(runner.minTime <= 0.0) { usage(); return 1; }
+
+    addEngine<StandardGame>(runner, "standard");
+    addEngine<DynamicGame>(runner, "dynamic");
+
+    std::printf("simd %s   min-time %.2f s\n", simdLevelName(getSimdLevel()), runner.minTime);
+    std::vector<bench::Result> results = runner.run(filter);
+
+    if(jsonPath && !bench::Runner::writeJson(jsonPath, results, simdLevelName(getSimdLevel()))) {
+        std::fprintf(stderr, "cannot write %s\n", jsonPath);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,412 @@
+// tetris_render_bench.cpp
+// Бенчмарк кадра без окна: Renderer + BoardView (то же, что рисует игра) во внеэкранном
+// контексте EGL. На Linux без GPU работает на Mesa llvmpipe, поэтому годится для CI.
+// Партия детерминирована (seed, случайная политика), так что последовательность полей
+// одна и та же от запуска к запуску; draw calls и вызовы GL на кадр не зависят от машины.
+//
+//   tetris_render_bench [--frames N] [--warmup N] [--size WxH] [--width W] [--height H]
+//                       [--seed S] [--json FILE] [--ppm FILE] [--profile 1] [--trace FILE]
+//
+// --profile 1 включает профилировщик (зоны PROFILE_SCOPE, счётчики, время GPU по фазам)
+// и печатает средние за кадр; сами замеры тогда немного дороже. --trace пишет кадры
+// прогона (без прогрева) в Chrome trace JSON.
+//
+// Запускать из корня проекта (шейдеры читаются из shaders/).
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "BoardKernels.h"
+#include "BoardView.h"
+#include "GLState.h"
+#include "Game.h"
+#include "GpuTimer.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "Renderer.h"
+#include "TraceRecorder.h"
+
+// ---------------------------------------------------------------- подсчёт вызовов GL
+
+// Считается каждый вызов через glad, включая запросы GpuTimer и glFinish: отладочная glad
+// (генератор c-debug, CMake находит её и задаёт TETRIS_GLAD_DEBUG) после каждой функции
+// зовёт post-callback с её именем. Draw call — glDraw* и glMultiDraw*.
+// С обычной glad вызовы не считаются, печатается только время.
+static long long glCalls = 0;
+static long long drawCalls = 0;
+
+#ifdef TETRIS_GLAD_DEBUG
+static const bool GL_CALLS_COUNTED = true;
+
+// Заменяет и стандартный post-callback glad, который после каждого вызова зовёт glGetError
+static void countGLCall(const char *name, void *, int, ...)
+{
+    ++glCalls;
+    if(!std::strncmp(name, "glDraw", 6) || !std::strncmp(name, "glMultiDraw", 11)) ++drawCalls;
+}
+#else
+static const bool GL_CALLS_COUNTED = false;
+#endif
+
+// ---------------------------------------------------------------- контекст
+
+// Контекст OpenGL 3.3 core без поверхности (EGL_KHR_surfaceless_context):
+// рисуем в свой framebuffer, окно и X-сервер не нужны
+static bool createContext(EGLDisplay &display, EGLContext &context)
+{
+    display = EGL_NO_DISPLAY;
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if(getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+#endif
+    if(display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if(display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) return false;
+    if(!eglBindAPI(EGL_OPENGL_API)) return false;
+
+    // По умолчанию EGL_SURFACE_TYPE = EGL_WINDOW_BIT, а окон у surfaceless-платформы нет
+    const EGLint configAttribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    EGLConfig config;
+    EGLint count = 0;
+    if(!eglChooseConfig(display, configAttribs, &config, 1, &count) || count == 0) return false;
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    return context != EGL_NO_CONTEXT && eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+}
+
+struct Framebuffer {
+    unsigned int fbo, color, depth;
+};
+
+static bool createFramebuffer(int width, int height, Framebuffer &fb)
+{
+    glGenFramebuffers(1, &fb.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fb.fbo);
+    glGenRenderbuffers(1, &fb.color);
+    glBindRenderbuffer(GL_RENDERBUFFER, fb.color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, fb.color);
+    glGenRenderbuffers(1, &fb.depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, fb.depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, fb.depth);
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+// Последний кадр в PPM — посмотреть глазами, что нарисовано на CI
+static bool writePpm(const char *path, int width, int height)
+{
+    std::vector<unsigned char> pixels((size_t)width * height * 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    std::FILE *f = std::fopen(path, "wb");
+    if(!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", width, height);
+    for(int y = height - 1; y >= 0; --y)
+        for(int x = 0; x < width; ++x)
+            std::fwrite(&pixels[((size_t)y * width + x) * 4], 1, 3, f);
+    std::fclose(f);
+    return true;
+}
+
+// ---------------------------------------------------------------- кадр
+
+struct BenchOptions {
+    int frames = 600;
+    int warmup = 60;
+    int viewWidth = 1280, viewHeight = 720;
+    int width = DynamicGame::DEFAULT_WIDTH;
+    int height = DynamicGame::DEFAULT_HEIGHT;
+    uint64_t seed = 1;
+    const char *jsonPath = nullptr;
+    const char *ppmPath = nullptr;
+    const char *tracePath = nullptr;
+    bool profile = false;
+};
+
+// Фиксированная последовательность полей: фигура падает с тиком 60 Гц, каждые
+// DROP_EVERY кадров случайно поворачивается, сдвигается и сбрасывается (как
+// tetris_batch --policy random). После Game Over — новая партия со следующим seed.
+class BoardReplay {
+public:
+    static const int DROP_EVERY = 12;
+
+    BoardReplay(int width, int height, uint64_t seed)
+        : game(width, height, seed), prevActive(game.getActive()), rng(seed), seed(seed) {}
+
+    void step(int frame)
+    {
+        int pieces = game.getPieces();
+        prevActive = game.getActive();
+        game.update(1.0f / 60.0f);
+        if(frame % DROP_EVERY == DROP_EVERY - 1) {
+            int rotations = (int)rng.nextBelow(4);
+            for(int i = 0; i < rotations; ++i) game.rotate();
+            int shift = (int)rng.nextBelow(game.getWidth()) - game.getWidth() / 2;
+            for(int i = 0; i < shift; ++i) game.moveRight();
+            for(int i = 0; i > shift; --i) game.moveLeft();
+            game.hardDrop();
+        }
+        if(game.isGameOver()) {
+            game.reset(++seed);
+            ++restarts;
+        }
+        // Новая фигура или партия — как в main.cpp, без интерполяции
+        if(game.getPieces() != pieces) prevActive = game.getActive();
+    }
+
+    DynamicGame game;
+    Piece prevActive;
+    Rng rng;
+    uint64_t seed;
+    int restarts = 0;
+};
+
+static double percentile(std::vector<double> values, double p)
+{
+    std::sort(values.begin(), values.end());
+    size_t i = (size_t)(p * (values.size() - 1) + 0.5);
+    return values[i];
+}
+
+// Средние за кадр по зонам и счётчикам профилировщика; GPU — последний прочитанный кадр
+static void printProfile(const GpuTimer &gpuTimer)
+{
+    double frames = (double)std::max<int64_t>(profiler::getFrameCount(), 1);
+    std::printf("%-16s %10s %10s\n", "zone", "ms/frame", "calls");
+    for(int i = 0; i < profiler::getZoneCount(); ++i) {
+        profiler::ZoneStats z = profiler::getZone(i);
+        std::printf("%-16s %10.3f %10d\n", z.name, z.totalMs / frames, z.calls);
+    }
+    for(int i = 0; i < profiler::getCounterCount(); ++i) {
+        profiler::CounterStats c = profiler::getCounter(i);
+        std::printf("%-16s %10.2f /frame\n", c.name, c.total / frames);
+    }
+    if(!gpuTimer.isSupported()) std::printf("GPU timer queries not supported\n");
+    for(int i = 0; i < gpuTimer.getPhaseCount(); ++i)
+        std::printf("GPU %-12s %10.3f ms\n", gpuTimer.getPhaseName(i), gpuTimer.getPhaseMs(i));
+}
+
+static void usage()
+{
+    std::fprintf(stderr,
+                 "usage: tetris_render_bench [--frames N] [--warmup N] [--size WxH] [--width %d..%d] [--height %d..%d]\n"
+                 "                           [--seed S] [--json FILE] [--ppm FILE] [--profile 0|1]\n"
+                 "                           [--trace FILE]\n",
+                 DynamicGame::MIN_SIZE, DynamicGame::MAX_WIDTH, DynamicGame::MIN_SIZE, DynamicGame::MAX_HEIGHT);
+}
+
+static bool parseArgs(int argc, char **argv, BenchOptions &opt)
+{
+    for(int i = 1; i < argc; i += 2) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if(!value) return false;
+        if(!std::strcmp(arg, "--frames")) opt.frames = std::atoi(value);
+        else if(!std::strcmp(arg, "--warmup")) opt.warmup = std::atoi(value);
+        else if(!std::strcmp(arg, "--size")) {
+            if(std::sscanf(value, "%dx%d", &opt.viewWidth, &opt.viewHeight) != 2) return false;
+        }
+        else if(!std::strcmp(arg, "--width")) opt.width = std::atoi(value);
+        else if(!std::strcmp(arg, "--height")) opt.height = std::atoi(value);
+        else if(!std::strcmp(arg, "--seed")) opt.seed = std::strtoull(value, nullptr, 10);
+        else if(!std::strcmp(arg, "--json")) opt.jsonPath = value;
+        else if(!std::strcmp(arg, "--ppm")) opt.ppmPath = value;
+        else if(!std::strcmp(arg, "--profile")) opt.profile = std::atoi(value) != 0;
+        else if(!std::strcmp(arg, "--trace")) opt.tracePath = value;
+        else return false;
+    }
+    return opt.frames > 0 && opt.warmup >= 0 &&
+           opt.viewWidth > 0 && opt.viewHeight > 0 && opt.viewWidth <= 8192 && opt.viewHeight <= 8192 &&
+           opt.width >= DynamicGame::MIN_SIZE && opt.width <= DynamicGame::MAX_WIDTH &&
+           opt.height >= DynamicGame::MIN_SIZE && opt.height <= DynamicGame::MAX_HEIGHT;
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions opt;
+    if(!parseArgs(argc, argv, opt)) { usage(); return 1; }
+
+    if(!std::ifstream("shaders/pbr.vs") || !std::ifstream("shaders/pbr.fs")) {
+        std::fprintf(stderr, "shaders/pbr.vs not found: run from the project root\n");
+        return 1;
+    }
+
+    EGLDisplay display;
+    EGLContext context;
+    if(!createContext(display, context)) {
+        std::fprintf(stderr, "cannot create an OpenGL 3.3 core EGL context (error 0x%x)\n", (unsigned)eglGetError());
+        return 1;
+    }
+    if(!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        std::fprintf(stderr, "cannot load OpenGL functions\n");
+        return 1;
+    }
+#ifdef TETRIS_GLAD_DEBUG
+    glad_set_post_callback(countGLCall);
+#endif
+    Framebuffer fb;
+    if(!createFramebuffer(opt.viewWidth, opt.viewHeight, fb)) {
+        std::fprintf(stderr, "cannot create a %dx%d framebuffer\n", opt.viewWidth, opt.viewHeight);
+        return 1;
+    }
+    glstate::enable(GL_DEPTH_TEST);
+
+    std::printf("renderer %s, GL %s\n", (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+    std::printf("board %dx%d, viewport %dx%d, %d frames (+%d warmup), seed %llu\n",
+                opt.width, opt.height, opt.viewWidth, opt.viewHeight, opt.frames, opt.warmup,
+                (unsigned long long)opt.seed);
+
+    std::vector<double> submitMs, frameMs;
+    submitMs.reserve(opt.frames);
+    frameMs.reserve(opt.frames);
+    long long measuredGLCalls = 0, measuredDrawCalls = 0, measuredElided = 0;
+    std::clock_t cpuStart = 0;
+    {
+        Renderer renderer;
+        BoardView boardView(renderer, opt.width, opt.height);
+        BoardCamera camera = boardCamera(opt.width, opt.height);
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)opt.viewWidth / opt.viewHeight,
+                                                0.1f, camera.farPlane);
+        BoardReplay replay(opt.width, opt.height, opt.seed);
+        GpuTimer gpuTimer;
+        profiler::setEnabled(opt.profile);
+
+        // Кадр — как в main.cpp без ImGui и swap; alpha фиксирован, чтобы вершины не зависели от времени
+        glstate::Stats stateStart = glstate::getStats();
+        for(int frame = 0; frame < opt.warmup + opt.frames; ++frame) {
+            if(frame == opt.warmup) {
+                glFinish();
+                glCalls = drawCalls = 0;
+                stateStart = glstate::getStats();
+                cpuStart = std::clock();
+                profiler::resetTotals();
+                trace::setEnabled(opt.tracePath != nullptr);
+            }
+            auto start = std::chrono::steady_clock::now();
+            gpuTimer.beginFrame();
+
+            {
+                PROFILE_SCOPE("sim");
+                replay.step(frame);
+            }
+
+            glstate::viewport(0, 0, opt.viewWidth, opt.viewHeight);
+            glClearColor(0.05f, 0.05f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            renderer.beginFrame(camera.view, projection, camera.position);
+
+            {
+                PROFILE_SCOPE("wall draw");
+                PROFILE_GPU_SCOPE(gpuTimer, "walls");
+                boardView.drawWalls();
+            }
+            {
+                PROFILE_SCOPE("board draw");
+                PROFILE_GPU_SCOPE(gpuTimer, "board");
+                boardView.update(replay.game);
+                boardView.drawBoard();
+                boardView.drawActivePiece(replay.game, replay.prevActive, 0.5f);
+            }
+
+            auto submitted = std::chrono::steady_clock::now();
+            glFinish();   // llvmpipe растеризует в своих потоках: ждём, чтобы кадр был честным
+            auto finished = std::chrono::steady_clock::now();
+
+            double ms = std::chrono::duration<double, std::milli>(finished - start).count();
+            if(frame >= opt.warmup) {
+                submitMs.push_back(std::chrono::duration<double, std::milli>(submitted - start).count());
+                frameMs.push_back(ms);
+            }
+            profiler::endFrame(ms);
+        }
+        measuredGLCalls = glCalls;
+        measuredDrawCalls = drawCalls;
+        measuredElided = glstate::getStats().elided - stateStart.elided;
+        std::printf("games restarted: %d\n", replay.restarts);
+        if(opt.profile) printProfile(gpuTimer);
+        trace::setEnabled(false);
+    }
+    double cpuSeconds = (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    if(GLenum error = glGetError()) {
+        std::fprintf(stderr, "GL error 0x%x\n", error);
+        return 1;
+    }
+    if(opt.tracePath && !trace::writeChromeJson(opt.tracePath, 1e9)) {
+        std::fprintf(stderr, "cannot write %s\n", opt.tracePath);
+        return 1;
+    }
+    if(opt.ppmPath && !writePpm(opt.ppmPath, opt.viewWidth, opt.viewHeight)) {
+        std::fprintf(stderr, "cannot write %s\n", opt.ppmPath);
+        return 1;
+    }
+
+    double submitMean = 0.0, frameMean = 0.0;
+    for(int i = 0; i < opt.frames; ++i) {
+        submitMean += submitMs[i];
+        frameMean += frameMs[i];
+    }
+    submitMean /= opt.frames;
+    frameMean /= opt.frames;
+    double glPerFrame = (double)measuredGLCalls / opt.frames;
+    double drawPerFrame = (double)measuredDrawCalls / opt.frames;
+    double elidedPerFrame = (double)measuredElided / opt.frames;
+
+    std::printf("%-10s %10s %10s %10s %10s\n", "ms/frame", "mean", "p50", "p95", "max");
+    std::printf("%-10s %10.3f %10.3f %10.3f %10.3f\n", "submit", submitMean,
+                percentile(submitMs, 0.5), percentile(submitMs, 0.95), percentile(submitMs, 1.0));
+    std::printf("%-10s %10.3f %10.3f %10.3f %10.3f\n", "frame", frameMean,
+                percentile(frameMs, 0.5), percentile(frameMs, 0.95), percentile(frameMs, 1.0));
+    if(GL_CALLS_COUNTED)
+        std::printf("draw calls/frame %.2f, GL calls/frame %.2f (%.2f elided by state cache), "
+                    "CPU (all threads) %.3f ms/frame\n",
+                    drawPerFrame, glPerFrame, elidedPerFrame, cpuSeconds * 1e3 / opt.frames);
+    else
+        std::printf("GL calls not counted (glad without c-debug), %.2f elided by state cache/frame, "
+                    "CPU (all threads) %.3f ms/frame\n",
+                    elidedPerFrame, cpuSeconds * 1e3 / opt.frames);
+
+    if(opt.jsonPath) {
+        std::string prefix = "render/" + std::to_string(opt.width) + "x" + std::to_string(opt.height) + "/";
+        std::vector<bench::Result> results(2);
+        results[0].name = prefix + "submit";
+        results[0].realNs = results[0].cpuNs = submitMean * 1e6;
+        results[1].name = prefix + "frame";
+        results[1].realNs = frameMean * 1e6;
+        results[1].cpuNs = cpuSeconds * 1e9 / opt.frames;
+        for(auto &r : results) {
+            r.iterations = opt.frames;
+            r.itemsPerSecond = 0.0;
+            if(GL_CALLS_COUNTED) r.counters = {{"draw_calls", drawPerFrame}, {"gl_calls", glPerFrame}};
+            r.counters.push_back({"gl_calls_elided", elidedPerFrame});
+        }
+        if(!bench::Runner::writeJson(opt.jsonPath, results, simdLevelName(getSimdLevel()))) {
+            std::fprintf(stderr, "cannot write %s\n", opt.jsonPath);
+            return 1;
+        }
+    }
+
+    glDeleteRenderbuffers(1, &fb.color);
+    glDeleteRenderbuffers(1, &fb.depth);
+    glDeleteFramebuffers(1, &fb.fbo);
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+    eglTerminate(display);
+    return 0;
+}